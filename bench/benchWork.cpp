@@ -0,0 +1,531 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/detachedTask.h>
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/loops.h>
+#include <pxr/work/reduce.h>
+#include <pxr/work/singularTask.h>
+#include <pxr/work/sort.h>
+#include <pxr/work/threadLimits.h>
+
+#include <benchmark/benchmark.h>
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace pxr;
+
+// Every benchmark takes the number of threads as argument \p threadsArg and
+// runs its timing loop inside a task arena of that size, so the Work primitives
+// see the corresponding concurrency limit (including the serial fallback for 1).
+template <class Fn>
+static void
+_RunWithThreads(benchmark::State &state, int threadsArg, Fn &&fn)
+{
+    const int numThreads = static_cast<int>(state.range(threadsArg));
+    tbb::task_arena arena(numThreads);
+    arena.execute(std::forward<Fn>(fn));
+    state.counters["threads"] = numThreads;
+}
+
+// Burn roughly \p iterations units of work that the compiler cannot elide.
+static inline uint64_t
+_Payload(uint64_t seed, int64_t iterations)
+{
+    for (int64_t i = 0; i < iterations; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return seed;
+}
+
+// Powers of two up to, and including, the physical concurrency limit.
+static std::vector<int64_t>
+_ThreadCounts()
+{
+    const int64_t maxThreads = WorkGetPhysicalConcurrencyLimit();
+    std::vector<int64_t> counts;
+    for (int64_t n = 1; n < maxThreads; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkParallelForN
+//
+// Args: n, grainSize, payload, threads
+
+static void
+BM_ParallelForN(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const size_t grainSize = state.range(1);
+    const int64_t payload = state.range(2);
+    std::vector<uint64_t> data(n);
+
+    _RunWithThreads(state, 3, [&]() {
+        for (auto _ : state) {
+            WorkParallelForN(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    data[i] = _Payload(i, payload);
+                }
+            }, grainSize);
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelForN)
+    ->ArgNames({"n", "grain", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 20}, {1, 64, 4096}, {0, 64}, _ThreadCounts()})
+    ->UseRealTime();
+
+// Same as above, but with an explicit partitioner that persists across
+// iterations of the benchmark, the way iterative solvers would hold one.
+//
+// Args: n, grainSize, partitioner (0: auto, 1: static, 2: affinity), threads
+static void
+BM_ParallelForNPartitioner(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const size_t grainSize = state.range(1);
+    const int64_t mode = state.range(2);
+    std::vector<uint64_t> data(n);
+    WorkAffinityPartitioner affinityPartitioner;
+
+    _RunWithThreads(state, 3, [&]() {
+        for (auto _ : state) {
+            auto fn = [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    data[i] = _Payload(data[i], 8);
+                }
+            };
+            if (mode == 1) {
+                WorkParallelForN(n, fn, grainSize, WorkStaticPartitioner());
+            } else if (mode == 2) {
+                WorkParallelForN(n, fn, grainSize, affinityPartitioner);
+            } else {
+                WorkParallelForN(n, fn, grainSize);
+            }
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelForNPartitioner)
+    ->ArgNames({"n", "grain", "partitioner", "threads"})
+    ->ArgsProduct({{1 << 16, 1 << 22}, {1024}, {0, 1, 2}, _ThreadCounts()})
+    ->UseRealTime();
+
+// Same as above, but letting WorkParallelForNAdaptive pick the grain size.
+//
+// Args: n, payload, threads
+static void
+BM_ParallelForNAdaptive(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const int64_t payload = state.range(1);
+    std::vector<uint64_t> data(n);
+    size_t grainSize = 0;
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            grainSize = WorkParallelForNAdaptive(n,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i != end; ++i) {
+                        data[i] = _Payload(i, payload);
+                    }
+                });
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["grain"] = grainSize;
+}
+
+BENCHMARK(BM_ParallelForNAdaptive)
+    ->ArgNames({"n", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 20}, {0, 64}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkParallelReduceN, WorkParallelDeterministicReduceN
+//
+// Args: n, grainSize, threads
+
+static void
+BM_ParallelReduceN(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const size_t grainSize = state.range(1);
+    std::vector<double> data(n);
+    std::iota(data.begin(), data.end(), 0.0);
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            double sum = WorkParallelReduceN(
+                0.0, n,
+                [&data](size_t begin, size_t end, double value) {
+                    for (size_t i = begin; i != end; ++i) {
+                        value += data[i];
+                    }
+                    return value;
+                },
+                [](double lhs, double rhs) { return lhs + rhs; },
+                grainSize);
+            benchmark::DoNotOptimize(sum);
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelReduceN)
+    ->ArgNames({"n", "grain", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 20}, {1, 64, 4096}, _ThreadCounts()})
+    ->UseRealTime();
+
+static void
+BM_ParallelDeterministicReduceN(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const size_t grainSize = state.range(1);
+    std::vector<double> data(n);
+    std::iota(data.begin(), data.end(), 0.0);
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            double sum = WorkParallelDeterministicReduceN(
+                0.0, n,
+                [&data](size_t begin, size_t end, double value) {
+                    for (size_t i = begin; i != end; ++i) {
+                        value += data[i];
+                    }
+                    return value;
+                },
+                [](double lhs, double rhs) { return lhs + rhs; },
+                grainSize);
+            benchmark::DoNotOptimize(sum);
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelDeterministicReduceN)
+    ->ArgNames({"n", "grain", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 20}, {64, 4096}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkParallelSort, WorkParallelStableSort, WorkParallelRadixSort
+//
+// Args: n, threads
+
+static std::vector<uint32_t>
+_RandomKeys(size_t n)
+{
+    std::mt19937 gen(n);
+    std::vector<uint32_t> keys(n);
+    for (uint32_t &k : keys) {
+        k = gen();
+    }
+    return keys;
+}
+
+static void
+BM_ParallelSort(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const std::vector<uint32_t> input = _RandomKeys(n);
+    std::vector<uint32_t> data;
+
+    _RunWithThreads(state, 1, [&]() {
+        for (auto _ : state) {
+            state.PauseTiming();
+            data = input;
+            state.ResumeTiming();
+            WorkParallelSort(&data);
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelSort)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 12, 1 << 20}, _ThreadCounts()})
+    ->UseRealTime();
+
+static void
+BM_ParallelStableSort(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const std::vector<uint32_t> input = _RandomKeys(n);
+    std::vector<uint32_t> data;
+
+    _RunWithThreads(state, 1, [&]() {
+        for (auto _ : state) {
+            state.PauseTiming();
+            data = input;
+            state.ResumeTiming();
+            WorkParallelStableSort(&data);
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelStableSort)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 12, 1 << 20}, _ThreadCounts()})
+    ->UseRealTime();
+
+static void
+BM_ParallelRadixSort(benchmark::State &state)
+{
+    const size_t n = state.range(0);
+    const std::vector<uint32_t> input = _RandomKeys(n);
+    std::vector<uint32_t> data;
+
+    _RunWithThreads(state, 1, [&]() {
+        for (auto _ : state) {
+            state.PauseTiming();
+            data = input;
+            state.ResumeTiming();
+            WorkParallelRadixSort(&data);
+            benchmark::ClobberMemory();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ParallelRadixSort)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 12, 1 << 20}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkDispatcher::Run / Wait
+//
+// Args: numTasks, payload, threads
+
+static void
+BM_DispatcherRunWait(benchmark::State &state)
+{
+    const int64_t numTasks = state.range(0);
+    const int64_t payload = state.range(1);
+    std::atomic<uint64_t> sink { 0 };
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            WorkDispatcher dispatcher;
+            for (int64_t i = 0; i != numTasks; ++i) {
+                dispatcher.Run([&sink, i, payload]() {
+                    sink.fetch_add(
+                        _Payload(i, payload), std::memory_order_relaxed);
+                });
+            }
+            dispatcher.Wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+BENCHMARK(BM_DispatcherRunWait)
+    ->ArgNames({"tasks", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16}, {0, 1024}, _ThreadCounts()})
+    ->UseRealTime();
+
+// Same as above, but without transporting errors.
+static void
+BM_DispatcherRunNoErrorTransport(benchmark::State &state)
+{
+    const int64_t numTasks = state.range(0);
+    const int64_t payload = state.range(1);
+    std::atomic<uint64_t> sink { 0 };
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            WorkDispatcher dispatcher;
+            for (int64_t i = 0; i != numTasks; ++i) {
+                dispatcher.RunNoErrorTransport([&sink, i, payload]() {
+                    sink.fetch_add(
+                        _Payload(i, payload), std::memory_order_relaxed);
+                });
+            }
+            dispatcher.Wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+BENCHMARK(BM_DispatcherRunNoErrorTransport)
+    ->ArgNames({"tasks", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16}, {0, 1024}, _ThreadCounts()})
+    ->UseRealTime();
+
+// Same as above, but using the variadic Run() that binds arguments.
+static void
+_AccumulatePayload(std::atomic<uint64_t> *sink, int64_t i, int64_t payload)
+{
+    sink->fetch_add(_Payload(i, payload), std::memory_order_relaxed);
+}
+
+static void
+BM_DispatcherRunArgs(benchmark::State &state)
+{
+    const int64_t numTasks = state.range(0);
+    const int64_t payload = state.range(1);
+    std::atomic<uint64_t> sink { 0 };
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            WorkDispatcher dispatcher;
+            for (int64_t i = 0; i != numTasks; ++i) {
+                dispatcher.Run(&_AccumulatePayload, &sink, i, payload);
+            }
+            dispatcher.Wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+BENCHMARK(BM_DispatcherRunArgs)
+    ->ArgNames({"tasks", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16}, {0, 1024}, _ThreadCounts()})
+    ->UseRealTime();
+
+// Same as above, but submitting all tasks at once with RunN().
+static void
+BM_DispatcherRunN(benchmark::State &state)
+{
+    const int64_t numTasks = state.range(0);
+    const int64_t payload = state.range(1);
+    std::atomic<uint64_t> sink { 0 };
+
+    _RunWithThreads(state, 2, [&]() {
+        for (auto _ : state) {
+            WorkDispatcher dispatcher;
+            dispatcher.RunN(numTasks, [&sink, payload](size_t i) {
+                sink.fetch_add(
+                    _Payload(i, payload), std::memory_order_relaxed);
+            });
+            dispatcher.Wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+BENCHMARK(BM_DispatcherRunN)
+    ->ArgNames({"tasks", "payload", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16}, {0, 1024}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkSingularTask::Wake
+//
+// Args: numWakes, threads
+
+static void
+BM_SingularTaskWake(benchmark::State &state)
+{
+    const int64_t numWakes = state.range(0);
+    std::atomic<uint64_t> runs { 0 };
+
+    _RunWithThreads(state, 1, [&]() {
+        for (auto _ : state) {
+            WorkDispatcher dispatcher;
+            WorkSingularTask task(dispatcher, [&runs]() {
+                runs.fetch_add(1, std::memory_order_relaxed);
+            });
+            // Wake the consumer from many producer tasks at once, which is the
+            // contended case WorkSingularTask is designed for.
+            WorkParallelForN(numWakes, [&task](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    task.Wake();
+                }
+            });
+            dispatcher.Wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numWakes);
+    state.counters["runs"] = benchmark::Counter(
+        runs.load(), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_SingularTaskWake)
+    ->ArgNames({"wakes", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// WorkRunDetachedTask
+//
+// Measures submission plus completion, since detached tasks offer no way to
+// wait other than observing their side effects.
+//
+// Args: numTasks, threads
+
+static void
+BM_RunDetachedTask(benchmark::State &state)
+{
+    const int64_t numTasks = state.range(0);
+
+    _RunWithThreads(state, 1, [&]() {
+        for (auto _ : state) {
+            std::atomic<int64_t> counter { 0 };
+            for (int64_t i = 0; i != numTasks; ++i) {
+                WorkRunDetachedTask([&counter]() {
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            while (counter.load() != numTasks) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+BENCHMARK(BM_RunDetachedTask)
+    ->ArgNames({"tasks", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 14}, _ThreadCounts()})
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+int
+main(int argc, char **argv)
+{
+    // Report JSON on stdout unless a format was explicitly requested, so runs
+    // can be archived and compared across rebases without extra flags.  Note
+    // that --benchmark_out=<file> already defaults to JSON.
+    std::vector<char *> args(argv, argv + argc);
+    static char jsonFormat[] = "--benchmark_format=json";
+    if (std::none_of(args.begin(), args.end(), [](const char *arg) {
+            return std::strncmp(arg, "--benchmark_format", 18) == 0; })) {
+        args.push_back(jsonFormat);
+    }
+
+    int numArgs = static_cast<int>(args.size());
+    benchmark::Initialize(&numArgs, args.data());
+    if (benchmark::ReportUnrecognizedArguments(numArgs, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
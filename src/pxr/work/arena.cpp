@@ -0,0 +1,106 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./arena.h"
+#include "./threadLimits.h"
+
+namespace pxr {
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+static tbb::task_arena::priority
+_GetTbbPriority(WorkTaskPriority priority)
+{
+    switch (priority) {
+    case WorkTaskPriority::Low:
+        return tbb::task_arena::priority::low;
+    case WorkTaskPriority::High:
+        return tbb::task_arena::priority::high;
+    case WorkTaskPriority::Normal:
+        break;
+    }
+    return tbb::task_arena::priority::normal;
+}
+#endif
+
+static thread_local tbb::task_arena *_currentArena = nullptr;
+
+tbb::task_arena *
+Work_GetCurrentArena()
+{
+    return _currentArena;
+}
+
+tbb::task_arena *
+Work_SetCurrentArena(tbb::task_arena *arena)
+{
+    tbb::task_arena *previous = _currentArena;
+    _currentArena = arena;
+    return previous;
+}
+
+WorkArena::WorkArena(unsigned maxConcurrency, WorkTaskPriority priority)
+    : _maxConcurrency(maxConcurrency ? maxConcurrency :
+                      WorkGetConcurrencyLimit())
+    // Don't reserve a slot for external threads, so that the tasks enqueued
+    // by dispatchers can use all of the arena's concurrency.
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    , _arena(static_cast<int>(_maxConcurrency), 0, _GetTbbPriority(priority))
+#else
+    , _arena(static_cast<int>(_maxConcurrency), 0)
+#endif
+{
+}
+
+WorkArena::~WorkArena() = default;
+
+unsigned
+WorkArena::GetMaxConcurrency() const
+{
+    return _maxConcurrency;
+}
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+
+// Creates an arena in which enqueued tasks are run by worker threads, rather
+// than waiting for an external thread to join.
+static tbb::task_arena *
+_NewPriorityArena(tbb::task_arena::priority priority)
+{
+    return new tbb::task_arena(tbb::task_arena::automatic, 0, priority);
+}
+
+tbb::task_arena *
+Work_GetPriorityArena(WorkTaskPriority priority)
+{
+    // Deliberately leak these in case there are tasks still using them after
+    // we exit from main().
+    switch (priority) {
+    case WorkTaskPriority::Low: {
+        static tbb::task_arena *arena =
+            _NewPriorityArena(tbb::task_arena::priority::low);
+        return arena;
+    }
+    case WorkTaskPriority::High: {
+        static tbb::task_arena *arena =
+            _NewPriorityArena(tbb::task_arena::priority::high);
+        return arena;
+    }
+    case WorkTaskPriority::Normal:
+        break;
+    }
+    return nullptr;
+}
+
+#else
+
+tbb::task_arena *
+Work_GetPriorityArena(WorkTaskPriority)
+{
+    return nullptr;
+}
+
+#endif
+
+}  // namespace pxr
@@ -0,0 +1,144 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_ARENA_H
+#define PXR_WORK_ARENA_H
+
+/// \file work/arena.h
+
+#include "./api.h"
+
+// Blocked range is not used in this file, but this header happens to pull in
+// the TBB version header in a way that works in all TBB versions.
+#include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
+
+#include <utility>
+
+namespace pxr {
+
+/// \enum WorkTaskPriority
+///
+/// Priority of tasks run by a WorkDispatcher.
+///
+/// When threads become available, they are assigned to the highest priority
+/// work first, so higher priority tasks start ahead of lower priority tasks
+/// that were submitted earlier, such as latency-critical work ahead of bulk
+/// background work.  Priorities do not preempt tasks that are already
+/// running.
+///
+/// Priorities are only supported with oneTBB, and are ignored otherwise.
+///
+enum class WorkTaskPriority
+{
+    Low,
+    Normal,
+    High
+};
+
+// Return the arena in which the calling thread is running a WorkDispatcher
+// task or a WorkArena::Execute() callable, or nullptr if it is not known.
+WORK_API
+tbb::task_arena *Work_GetCurrentArena();
+
+// Set the arena returned by Work_GetCurrentArena() on the calling thread, and
+// return the previous one.
+WORK_API
+tbb::task_arena *Work_SetCurrentArena(tbb::task_arena *arena);
+
+// Sets the current arena of the calling thread for the lifetime of the
+// object, so that code entering another arena can restore it on exit.
+class Work_ScopedCurrentArena
+{
+public:
+    explicit Work_ScopedCurrentArena(tbb::task_arena *arena)
+        : _previous(Work_SetCurrentArena(arena)) {}
+
+    ~Work_ScopedCurrentArena() {
+        Work_SetCurrentArena(_previous);
+    }
+
+    Work_ScopedCurrentArena(Work_ScopedCurrentArena const &) = delete;
+    Work_ScopedCurrentArena &operator=(
+        Work_ScopedCurrentArena const &) = delete;
+
+private:
+    tbb::task_arena *_previous;
+};
+
+/// \class WorkArena
+///
+/// A WorkArena limits the number of threads that concurrently run the tasks
+/// given to it.
+///
+/// Independent subsystems sharing a process, such as scene loading and shader
+/// compilation, may each run their work in their own arena, so that a single
+/// heavy workload cannot occupy every thread and starve the others.  Arenas
+/// draw their threads from the process-wide pool, so they do not oversubscribe
+/// the machine, and threads move between arenas as they run out of work.
+///
+/// Tasks are given to an arena by constructing a WorkDispatcher with it, or
+/// by calling Execute(), in which case all Work constructs used by the
+/// callable, such as WorkParallelForN(), run their tasks in the arena.
+///
+/// \code
+/// WorkArena ioArena(2);
+/// WorkDispatcher ioDispatcher(ioArena);
+/// for (const std::string &path : paths) {
+///     ioDispatcher.Run(ReadFile, path);
+/// }
+/// ioDispatcher.Wait();
+/// \endcode
+///
+/// Arenas are only supported with oneTBB.  With legacy TBB, tasks given to
+/// an arena run as if they were not.
+///
+class WorkArena
+{
+public:
+    /// Create an arena that runs tasks on at most \p maxConcurrency threads,
+    /// with \p priority.  A \p maxConcurrency of 0 means the current
+    /// concurrency limit.
+    WORK_API explicit WorkArena(
+        unsigned maxConcurrency,
+        WorkTaskPriority priority = WorkTaskPriority::Normal);
+
+    WORK_API ~WorkArena();
+
+    WorkArena(WorkArena const &) = delete;
+    WorkArena &operator=(WorkArena const &) = delete;
+
+    /// Return the maximum number of threads running tasks in this arena.
+    WORK_API unsigned GetMaxConcurrency() const;
+
+    /// Invoke \p fn in this arena and return its result.
+    template <class Fn>
+    auto Execute(Fn &&fn) {
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+        return _arena.execute([this, &fn]() -> decltype(auto) {
+            Work_ScopedCurrentArena scope(&_arena);
+            return std::forward<Fn>(fn)();
+        });
+#else
+        return std::forward<Fn>(fn)();
+#endif
+    }
+
+private:
+    friend class WorkDispatcher;
+
+    unsigned _maxConcurrency;
+    tbb::task_arena _arena;
+};
+
+// Return the arena that runs tasks of the given priority, or nullptr if
+// tasks should run in the arena of the calling thread.  This is the case of
+// normal priority tasks, and of all tasks with legacy TBB.
+WORK_API
+tbb::task_arena *Work_GetPriorityArena(WorkTaskPriority priority);
+
+}  // namespace pxr
+
+#endif // PXR_WORK_ARENA_H
@@ -0,0 +1,53 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./cancellation.h"
+#include "./dispatcher.h"
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+#include <tbb/task.h>
+#endif
+
+namespace pxr {
+
+WorkCancellationToken::WorkCancellationToken()
+    : _cancelled(std::make_shared<std::atomic<bool>>(false))
+    , _dispatcher(nullptr)
+    , _context(nullptr)
+{
+}
+
+WorkCancellationToken::WorkCancellationToken(const WorkDispatcher &dispatcher)
+    : WorkCancellationToken()
+{
+    _dispatcher = &dispatcher;
+}
+
+/* static */
+WorkCancellationToken
+WorkCancellationToken::GetEnclosing()
+{
+    WorkCancellationToken token;
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    token._context = tbb::task::current_context();
+#else
+    token._context = tbb::task::self().group();
+#endif
+    return token;
+}
+
+void
+WorkCancellationToken::Cancel()
+{
+    _cancelled->store(true, std::memory_order_relaxed);
+}
+
+bool
+WorkCancellationToken::_IsDispatcherCancelled() const
+{
+    return _dispatcher->IsCancelled();
+}
+
+}  // namespace pxr
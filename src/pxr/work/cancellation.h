@@ -0,0 +1,88 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_CANCELLATION_H
+#define PXR_WORK_CANCELLATION_H
+
+/// \file work/cancellation.h
+
+#include "./api.h"
+
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <memory>
+
+namespace pxr {
+
+class WorkDispatcher;
+
+/// \class WorkCancellationToken
+///
+/// A WorkCancellationToken lets parallel loops stop early when the work they
+/// are part of is abandoned.
+///
+/// WorkParallelForN() and WorkParallelReduceN() run in an isolated context,
+/// so cancelling a WorkDispatcher does not affect loops run by its tasks,
+/// which then run to completion.  The overloads of these functions that take
+/// a token check it before running each subrange, and once it is cancelled
+/// they stop splitting the range and return as soon as the subranges already
+/// running complete.
+///
+/// A token is cancelled by calling Cancel() on it or on any of its copies.
+/// It may also be linked to a WorkDispatcher, or to the dispatcher running
+/// the current task with GetEnclosing(), so that it is also cancelled when
+/// that dispatcher is.
+///
+/// For example,
+///
+/// \code
+/// dispatcher.Run([&dispatcher]() {
+///     const WorkCancellationToken token(dispatcher);
+///     WorkParallelForN(n, ProcessRange, 1, token);
+///     if (token.IsCancelled()) {
+///         return;
+///     }
+///     ...
+/// });
+/// \endcode
+///
+class WorkCancellationToken
+{
+public:
+    /// Create a token that is only cancelled by Cancel().
+    WORK_API WorkCancellationToken();
+
+    /// Create a token that is also cancelled when \p dispatcher is.
+    /// \p dispatcher must outlive the token.
+    WORK_API explicit WorkCancellationToken(const WorkDispatcher &dispatcher);
+
+    /// Return a token that is cancelled when the dispatcher, or the parallel
+    /// loop, running the calling task is.  This must be called from within
+    /// such a task, and the token must not be used once the task completes.
+    /// Outside of tasks, return a token that is only cancelled by Cancel().
+    WORK_API static WorkCancellationToken GetEnclosing();
+
+    /// Cancel this token and all of its copies.
+    WORK_API void Cancel();
+
+    /// Return true if this token was cancelled.
+    bool IsCancelled() const {
+        return _cancelled->load(std::memory_order_relaxed) ||
+            (_dispatcher && _IsDispatcherCancelled()) ||
+            (_context && _context->is_group_execution_cancelled());
+    }
+
+private:
+    WORK_API bool _IsDispatcherCancelled() const;
+
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+    const WorkDispatcher *_dispatcher;
+    tbb::task_group_context *_context;
+};
+
+}  // namespace pxr
+
+#endif // PXR_WORK_CANCELLATION_H
@@ -0,0 +1,459 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_COROUTINE_H
+#define PXR_WORK_COROUTINE_H
+
+/// \file work/coroutine.h
+///
+/// Coroutine support for Work.  This requires C++20 coroutines, and is empty
+/// otherwise.  PXR_WORK_HAS_COROUTINES is defined when it is available.
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L \
+    && __has_include(<coroutine>)
+
+#define PXR_WORK_HAS_COROUTINES 1
+
+#include "./dispatcher.h"
+#include "./future.h"
+#include "./loops.h"
+
+#include <pxr/tf/diagnostic.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace pxr {
+
+template <class T>
+class WorkTask;
+
+// Promise state shared by all WorkTask coroutines, regardless of their result
+// type.
+class Work_TaskPromiseBase
+{
+public:
+    explicit Work_TaskPromiseBase(WorkDispatcher &dispatcher)
+        : _dispatcher(&dispatcher)
+        , _done(std::make_shared<Work_FutureState<void>>())
+        , _awaiter(nullptr)
+        , _cancelled(false) {}
+
+    WorkDispatcher &GetDispatcher() const {
+        return *_dispatcher;
+    }
+
+    void unhandled_exception() noexcept {
+        // Exceptions cannot be transported to the awaiter.
+        std::terminate();
+    }
+
+protected:
+    template <class T>
+    friend class WorkTask;
+    template <class T>
+    friend struct Work_TaskAwaiter;
+    friend struct Work_TaskResumeTask;
+    friend struct Work_TaskFinalAwaiter;
+    template <class Fn>
+    friend struct Work_ParallelForNAwaiter;
+
+    // Register awaiter to be resumed when this coroutine completes.  Return
+    // false if it has already completed.
+    bool _SetAwaiter(Work_TaskPromiseBase *awaiter) {
+        Work_TaskPromiseBase *expected = nullptr;
+        return _awaiter.compare_exchange_strong(
+            expected, awaiter, std::memory_order_acq_rel);
+    }
+
+    // Mark this coroutine as completed, and return the coroutine to resume
+    // next.  The frame may be destroyed by its owner as soon as the awaiter is
+    // exchanged, so only local copies are used afterwards.
+    std::coroutine_handle<> _Finish() {
+        const std::shared_ptr<Work_FutureState<void>> done = _done;
+        Work_TaskPromiseBase *awaiter = _awaiter.exchange(this);
+        done->SetValue();
+        if (awaiter) {
+            return awaiter->_handle;
+        }
+        return std::noop_coroutine();
+    }
+
+    // Complete this coroutine without resuming it, because it was cancelled,
+    // and cancel the chain of coroutines awaiting it.
+    void _Cancel() {
+        Work_TaskPromiseBase *promise = this;
+        while (promise) {
+            promise->_cancelled = true;
+            const std::shared_ptr<Work_FutureState<void>> done =
+                promise->_done;
+            Work_TaskPromiseBase *awaiter = promise->_awaiter.exchange(promise);
+            done->Cancel();
+            promise = awaiter;
+        }
+    }
+
+    WorkDispatcher *_dispatcher;
+    std::coroutine_handle<> _handle;
+
+    // Completed when the coroutine returns or is cancelled.  This is shared
+    // so that threads waiting on it never access a destroyed frame.
+    std::shared_ptr<Work_FutureState<void>> _done;
+
+    // The coroutine awaiting this one, or this promise once completed.
+    std::atomic<Work_TaskPromiseBase *> _awaiter;
+    bool _cancelled;
+};
+
+// Task run by the dispatcher to resume a coroutine.  If it is destroyed
+// without running, because the dispatcher was cancelled, the coroutine is
+// cancelled instead.
+struct Work_TaskResumeTask {
+    explicit Work_TaskResumeTask(Work_TaskPromiseBase *promise)
+        : _promise(promise) {}
+
+    Work_TaskResumeTask(Work_TaskResumeTask &&other)
+        : _promise(std::exchange(other._promise, nullptr)) {}
+    Work_TaskResumeTask(const Work_TaskResumeTask &other) = delete;
+    Work_TaskResumeTask &operator=(const Work_TaskResumeTask &other) = delete;
+
+    ~Work_TaskResumeTask() {
+        if (_promise) {
+            _promise->_Cancel();
+        }
+    }
+
+    void operator()() const {
+        std::exchange(_promise, nullptr)->_handle.resume();
+    }
+
+private:
+    mutable Work_TaskPromiseBase *_promise;
+};
+
+// Awaiter that schedules a coroutine on its dispatcher when it starts.
+struct Work_TaskInitialAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <class Promise>
+    void await_suspend(std::coroutine_handle<Promise> h) const {
+        Work_TaskPromiseBase &promise = h.promise();
+        promise.GetDispatcher().Run(Work_TaskResumeTask(&promise));
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// Awaiter that resumes the awaiting coroutine, if any, when a coroutine
+// completes.
+struct Work_TaskFinalAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <class Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> h) const noexcept {
+        return static_cast<Work_TaskPromiseBase &>(h.promise())._Finish();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template <class T>
+class Work_TaskPromise : public Work_TaskPromiseBase
+{
+public:
+    // The dispatcher is the first parameter of the coroutine, or the second
+    // one for member functions and lambdas.
+    template <class ... Args>
+    explicit Work_TaskPromise(WorkDispatcher &dispatcher, Args &&...)
+        : Work_TaskPromiseBase(dispatcher) {}
+
+    template <class Obj, class ... Args>
+    explicit Work_TaskPromise(Obj &&, WorkDispatcher &dispatcher, Args &&...)
+        : Work_TaskPromiseBase(dispatcher) {}
+
+    WorkTask<T> get_return_object();
+
+    Work_TaskInitialAwaiter initial_suspend() const noexcept {
+        return {};
+    }
+
+    Work_TaskFinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    template <class U>
+    void return_value(U &&value) {
+        _result.emplace(std::forward<U>(value));
+    }
+
+    std::optional<T> &GetResult() {
+        return _result;
+    }
+
+private:
+    std::optional<T> _result;
+};
+
+template <>
+class Work_TaskPromise<void> : public Work_TaskPromiseBase
+{
+public:
+    template <class ... Args>
+    explicit Work_TaskPromise(WorkDispatcher &dispatcher, Args &&...)
+        : Work_TaskPromiseBase(dispatcher) {}
+
+    template <class Obj, class ... Args>
+    explicit Work_TaskPromise(Obj &&, WorkDispatcher &dispatcher, Args &&...)
+        : Work_TaskPromiseBase(dispatcher) {}
+
+    WorkTask<void> get_return_object();
+
+    Work_TaskInitialAwaiter initial_suspend() const noexcept {
+        return {};
+    }
+
+    Work_TaskFinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void return_void() {}
+};
+
+// Awaiter for co_await on a WorkTask.  The awaiting coroutine is resumed by
+// the thread that completes the awaited one, through symmetric transfer.  If
+// the awaited coroutine was cancelled, so is the awaiting one.
+template <class T>
+struct Work_TaskAwaiter {
+    bool await_ready() const noexcept {
+        return promise->_done->IsReady() && !promise->_cancelled;
+    }
+
+    template <class Promise>
+    bool await_suspend(std::coroutine_handle<Promise> h) const {
+        Work_TaskPromiseBase &awaiter = h.promise();
+        if (promise->_SetAwaiter(&awaiter)) {
+            return true;
+        }
+        if (promise->_cancelled) {
+            awaiter._Cancel();
+            return true;
+        }
+        return false;
+    }
+
+    Work_TaskPromise<T> *promise;
+};
+
+/// \class WorkTask
+///
+/// The result of a coroutine run by a WorkDispatcher.
+///
+/// A function that returns a WorkTask and takes a WorkDispatcher as its first
+/// parameter, or its second parameter for member functions and lambdas, is a
+/// coroutine whose body runs as tasks of that dispatcher.  Calling it
+/// schedules it and returns immediately.  Within a coroutine, `co_await` on a
+/// WorkTask suspends until that task completes, without blocking the thread,
+/// and produces its result.  This lets multi-stage asynchronous work be
+/// written sequentially, rather than by nesting calls to
+/// WorkDispatcher::Run().
+///
+/// For example,
+///
+/// \code
+/// WorkTask<Layer> ProcessLayer(WorkDispatcher &d, std::string path) {
+///     std::string contents = co_await ReadLayer(d, path);
+///     co_return co_await ParseLayer(d, std::move(contents));
+/// }
+///
+/// WorkTask<Stage> ComposeStage(WorkDispatcher &d, Paths paths) {
+///     // Start processing every layer before waiting on any of them.
+///     std::vector<WorkTask<Layer>> tasks;
+///     for (const std::string &path : paths) {
+///         tasks.push_back(ProcessLayer(d, path));
+///     }
+///     std::vector<Layer> layers;
+///     for (WorkTask<Layer> &task : tasks) {
+///         layers.push_back(co_await std::move(task));
+///     }
+///     co_return Compose(layers);
+/// }
+/// \endcode
+///
+/// Errors posted by a coroutine are transported to the thread that calls
+/// WorkDispatcher::Wait(), as with Run().  If the dispatcher is cancelled, a
+/// coroutine that has not started, or that awaits a cancelled coroutine or a
+/// parallel loop in a cancelled dispatcher, is cancelled: it is never resumed,
+/// and neither are the coroutines awaiting it.
+///
+/// A WorkTask owns its coroutine, and destroying it waits for the coroutine to
+/// complete.  Outside of coroutines, use Get() or Wait() to retrieve the
+/// result.
+///
+template <class T>
+class WorkTask
+{
+public:
+    using promise_type = Work_TaskPromise<T>;
+
+    /// Construct an invalid task, not associated with any coroutine.
+    WorkTask() = default;
+
+    WorkTask(WorkTask &&other) noexcept
+        : _handle(std::exchange(other._handle, nullptr)) {}
+
+    WorkTask &operator=(WorkTask &&other) noexcept {
+        if (this != &other) {
+            _Destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~WorkTask() {
+        _Destroy();
+    }
+
+    /// Return true if this task is associated with a coroutine.
+    bool IsValid() const {
+        return bool(_handle);
+    }
+
+    /// Return true if the coroutine completed, or was cancelled.
+    bool IsReady() const {
+        return _handle.promise()._done->IsReady();
+    }
+
+    /// Wait for the coroutine to complete, executing other pending tasks in
+    /// the meantime, and return true if it ran to completion or false if it
+    /// was cancelled.  This must not be called from within a coroutine; use
+    /// co_await instead.
+    bool Wait() const {
+        _handle.promise()._done->Wait();
+        return !_handle.promise()._cancelled;
+    }
+
+    /// Wait for the coroutine to complete and return its result.  It is a
+    /// fatal error to call this if the coroutine was cancelled.
+    decltype(auto) Get() const {
+        if (!Wait()) {
+            TF_FATAL_ERROR("Getting the result of a cancelled coroutine");
+        }
+        if constexpr (!std::is_void<T>::value) {
+            return static_cast<const T &>(*_handle.promise().GetResult());
+        }
+    }
+
+    auto operator co_await() const & {
+        struct _Awaiter : Work_TaskAwaiter<T> {
+            decltype(auto) await_resume() const {
+                if constexpr (!std::is_void<T>::value) {
+                    return static_cast<const T &>(
+                        *this->promise->GetResult());
+                }
+            }
+        };
+        return _Awaiter { { &_handle.promise() } };
+    }
+
+    auto operator co_await() && {
+        struct _Awaiter : Work_TaskAwaiter<T> {
+            T await_resume() const {
+                if constexpr (!std::is_void<T>::value) {
+                    return std::move(*this->promise->GetResult());
+                }
+            }
+        };
+        return _Awaiter { { &_handle.promise() } };
+    }
+
+private:
+    friend class Work_TaskPromise<T>;
+
+    explicit WorkTask(std::coroutine_handle<promise_type> handle)
+        : _handle(handle) {}
+
+    void _Destroy() {
+        if (_handle) {
+            _handle.promise()._done->Wait();
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+template <class T>
+WorkTask<T>
+Work_TaskPromise<T>::get_return_object()
+{
+    _handle = std::coroutine_handle<Work_TaskPromise<T>>::from_promise(*this);
+    return WorkTask<T>(
+        std::coroutine_handle<Work_TaskPromise<T>>::from_promise(*this));
+}
+
+inline WorkTask<void>
+Work_TaskPromise<void>::get_return_object()
+{
+    _handle = std::coroutine_handle<Work_TaskPromise<void>>::from_promise(
+        *this);
+    return WorkTask<void>(
+        std::coroutine_handle<Work_TaskPromise<void>>::from_promise(*this));
+}
+
+// Awaiter for WorkCoParallelForN().
+template <class Fn>
+struct Work_ParallelForNAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <class Promise>
+    bool await_suspend(std::coroutine_handle<Promise> h) {
+        Work_TaskPromiseBase &promise = h.promise();
+        if (promise.GetDispatcher().IsCancelled()) {
+            promise._Cancel();
+            return true;
+        }
+        WorkParallelForN(n, std::move(fn), grainSize);
+        return false;
+    }
+
+    void await_resume() const noexcept {}
+
+    size_t n;
+    Fn fn;
+    size_t grainSize;
+};
+
+/// Return an awaitable that runs WorkParallelForN(\p n, \p fn, \p grainSize)
+/// when awaited within a WorkTask coroutine.
+///
+/// The awaiting thread takes part in the loop, and the coroutine continues on
+/// that thread as soon as the loop completes, so no additional task is
+/// scheduled.  If the coroutine's dispatcher was cancelled, the loop is not
+/// run and the coroutine is cancelled instead.
+///
+template <class Fn>
+Work_ParallelForNAwaiter<typename std::decay<Fn>::type>
+WorkCoParallelForN(size_t n, Fn &&fn, size_t grainSize = 1)
+{
+    return { n, std::forward<Fn>(fn), grainSize };
+}
+
+}  // namespace pxr
+
+#endif // __cpp_impl_coroutine
+
+#endif // PXR_WORK_COROUTINE_H
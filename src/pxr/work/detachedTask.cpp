@@ -9,12 +9,96 @@
 #include "./dispatcher.h"
 #include "./threadLimits.h"
 
+#include <pxr/tf/envSetting.h>
+
+#include <algorithm>
 #include <atomic>
-#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
 #include <thread>
 
 namespace pxr {
 
+TF_DEFINE_ENV_SETTING(
+    PXR_WORK_MAX_PENDING_DETACHED_TASKS, 0,
+    "Limits the number of detached tasks pending completion, beyond which "
+    "they run synchronously. 0 (default) means no limit.");
+
+TF_DEFINE_ENV_SETTING(
+    PXR_WORK_MAX_PENDING_DETACHED_TASK_MB, 0,
+    "Limits the estimated memory, in megabytes, held by detached tasks "
+    "pending completion, beyond which they run synchronously. 0 (default) "
+    "means no limit.");
+
+static std::atomic<size_t> _pendingTasks { 0 };
+static std::atomic<size_t> _pendingBytes { 0 };
+
+static std::atomic<size_t> &
+_GetMaxPendingTasks()
+{
+    static std::atomic<size_t> limit {
+        static_cast<size_t>(std::max(
+            0, TfGetEnvSetting(PXR_WORK_MAX_PENDING_DETACHED_TASKS))) };
+    return limit;
+}
+
+static std::atomic<size_t> &
+_GetMaxPendingBytes()
+{
+    static std::atomic<size_t> limit {
+        static_cast<size_t>(std::max(
+            0, TfGetEnvSetting(PXR_WORK_MAX_PENDING_DETACHED_TASK_MB))) <<
+        20 };
+    return limit;
+}
+
+bool
+Work_TryReserveDetachedTask(size_t estimatedBytes)
+{
+    const size_t maxTasks = _GetMaxPendingTasks().load(
+        std::memory_order_relaxed);
+    const size_t maxBytes = _GetMaxPendingBytes().load(
+        std::memory_order_relaxed);
+
+    const size_t tasks = _pendingTasks.fetch_add(
+        1, std::memory_order_relaxed) + 1;
+    const size_t bytes = _pendingBytes.fetch_add(
+        estimatedBytes, std::memory_order_relaxed) + estimatedBytes;
+
+    if ((maxTasks && tasks > maxTasks) || (maxBytes && bytes > maxBytes)) {
+        Work_ReleaseDetachedTask(estimatedBytes);
+        return false;
+    }
+    return true;
+}
+
+void
+Work_ReleaseDetachedTask(size_t estimatedBytes)
+{
+    _pendingBytes.fetch_sub(estimatedBytes, std::memory_order_relaxed);
+    _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void
+WorkSetDetachedTaskLimits(size_t maxPendingTasks, size_t maxPendingBytes)
+{
+    _GetMaxPendingTasks() = maxPendingTasks;
+    _GetMaxPendingBytes() = maxPendingBytes;
+}
+
+size_t
+WorkGetDetachedTaskQueueDepth()
+{
+    return _pendingTasks.load(std::memory_order_relaxed);
+}
+
+size_t
+WorkGetDetachedTaskBytesPending()
+{
+    return _pendingBytes.load(std::memory_order_relaxed);
+}
+
 WorkDispatcher &
 Work_GetDetachedDispatcher()
 {
@@ -24,11 +108,75 @@ Work_GetDetachedDispatcher()
     return *theDispatcher;
 }
 
+namespace {
+
+// State shared between the producers of detached tasks and the waiter
+// thread.  Deliberately leaked, like the dispatcher, since the waiter thread
+// may still be using it after we exit from main().
+struct _DetachedWaiterState
+{
+    // Set by producers when they submit tasks, and cleared by the waiter
+    // before it waits on the dispatcher.
+    std::atomic<bool> hasWork { false };
+    // Set at exit to stop the waiter thread.
+    std::atomic<bool> shutdown { false };
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+
+    void Notify() {
+        // Briefly take the lock so that the waiter cannot miss the wakeup
+        // between checking its predicate and blocking.
+        { std::lock_guard<std::mutex> lock(mutex); }
+        wakeUp.notify_one();
+    }
+};
+
+_DetachedWaiterState &
+_GetDetachedWaiterState()
+{
+    static _DetachedWaiterState *state = new _DetachedWaiterState;
+    return *state;
+}
+
+void
+_ShutdownDetachedWaiter()
+{
+    _DetachedWaiterState &state = _GetDetachedWaiterState();
+    state.shutdown = true;
+    state.Notify();
+}
+
+void
+_RunDetachedWaiter(WorkDispatcher &dispatcher, _DetachedWaiterState &state)
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.wakeUp.wait(lock, [&state]() {
+                return state.hasWork.load() || state.shutdown.load();
+            });
+        }
+        if (state.shutdown) {
+            return;
+        }
+        // Clear the flag before waiting, so tasks submitted while we wait
+        // wake us up again.
+        state.hasWork = false;
+        // Process detached tasks.
+        dispatcher.Wait();
+    }
+}
+
+} // anon
+
 static std::atomic<std::thread *> detachedWaiter { nullptr };
 
 void
 Work_EnsureDetachedTaskProgress()
 {
+    _DetachedWaiterState &state = _GetDetachedWaiterState();
+
     // Check to see if there's a waiter thread already.  If not, try to create
     // one.
     std::thread *c = detachedWaiter.load();
@@ -38,22 +186,24 @@ Work_EnsureDetachedTaskProgress()
             // We won the race, so start the waiter thread.
             WorkDispatcher &dispatcher = Work_GetDetachedDispatcher();
             *newThread =
-                std::thread([&dispatcher]() {
-                        while (true) {
-                            // Process detached tasks.
-                            dispatcher.Wait();
-                            // Now sleep for a bit, and try again.
-                            using namespace std::chrono_literals;
-                            std::this_thread::sleep_for(50ms);
-                        }
+                std::thread([&dispatcher, &state]() {
+                        _RunDetachedWaiter(dispatcher, state);
                     });
             newThread->detach();
+            std::atexit(_ShutdownDetachedWaiter);
         }
         else {
             // We lost the race, so delete our temporary thread.
             delete newThread;
         }
     }
+
+    // Only wake the waiter if it isn't already due to wait on the
+    // dispatcher.  This must be a read-modify-write, rather than a load, so
+    // that the waiter observes our task once it clears the flag.
+    if (!state.hasWork.exchange(true)) {
+        state.Notify();
+    }
 }
 
 }  // namespace pxr
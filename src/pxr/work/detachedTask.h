@@ -13,18 +13,78 @@
 #include <pxr/tf/errorMark.h>
 #include "./api.h"
 #include "./dispatcher.h"
+#include "./tracing.h"
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
 namespace pxr {
 
+// Account for a detached task of \p estimatedBytes about to be queued, and
+// return true, or return false without accounting for it if that would exceed
+// the limits set by WorkSetDetachedTaskLimits().
+WORK_API
+bool Work_TryReserveDetachedTask(size_t estimatedBytes);
+
+// Release the accounting for a detached task reserved with
+// Work_TryReserveDetachedTask() once it has run and been destroyed.
+WORK_API
+void Work_ReleaseDetachedTask(size_t estimatedBytes);
+
+// Holds the reservation of a queued detached task, and releases it when
+// destroyed.  Reservations move with the task, so that they are released
+// only once the queued task, and the objects it owns, are destroyed.
+class Work_DetachedTaskReservation
+{
+public:
+    Work_DetachedTaskReservation() = default;
+
+    Work_DetachedTaskReservation(Work_DetachedTaskReservation &&other)
+        : _estimatedBytes(other._estimatedBytes)
+        , _reserved(other._reserved) {
+        other._reserved = false;
+    }
+
+    Work_DetachedTaskReservation(Work_DetachedTaskReservation const &) = delete;
+    Work_DetachedTaskReservation &
+    operator=(Work_DetachedTaskReservation const &) = delete;
+
+    ~Work_DetachedTaskReservation() {
+        if (_reserved) {
+            Work_ReleaseDetachedTask(_estimatedBytes);
+        }
+    }
+
+    // Take ownership of a reservation of estimatedBytes.
+    void Reserve(size_t estimatedBytes) {
+        _estimatedBytes = estimatedBytes;
+        _reserved = true;
+    }
+
+private:
+    size_t _estimatedBytes = 0;
+    bool _reserved = false;
+};
+
+// The reservation is a base class, so that it is released after the
+// function, which may own the objects a detached task destroys.
 template <class Fn>
-struct Work_DetachedTask
+struct Work_DetachedTask : Work_DetachedTaskReservation
 {
-    explicit Work_DetachedTask(Fn &&fn) : _fn(std::move(fn)) {}
-    explicit Work_DetachedTask(Fn const &fn) : _fn(fn) {}
+    explicit Work_DetachedTask(Fn &&fn)
+        : _fn(std::move(fn)) {}
+    explicit Work_DetachedTask(Fn const &fn)
+        : _fn(fn) {}
+
+    Work_DetachedTask(Work_DetachedTask &&) = default;
+
     void operator()() const {
+        Invoke();
+    }
+
+    void Invoke() const {
+        WORK_TRACE_SCOPE("WorkRunDetachedTask");
         TfErrorMark m;
         _fn();
         m.Clear();
@@ -41,20 +101,55 @@ void Work_EnsureDetachedTaskProgress();
 
 /// Invoke \p fn asynchronously, discard any errors it produces, and provide
 /// no way to wait for it to complete.
+///
+/// \p estimatedBytes is an estimate of the memory held by \p fn until it
+/// completes, such as the size of objects it destroys.  If the detached tasks
+/// pending completion would exceed the limits set by
+/// WorkSetDetachedTaskLimits(), \p fn is instead invoked synchronously on the
+/// calling thread.
 template <class Fn>
-void WorkRunDetachedTask(Fn &&fn)
+void WorkRunDetachedTask(Fn &&fn, size_t estimatedBytes)
 {
     using FnType = typename std::remove_reference<Fn>::type;
     Work_DetachedTask<FnType> task(std::forward<Fn>(fn));
-    if (WorkHasConcurrency()) {
+    if (WorkHasConcurrency() && Work_TryReserveDetachedTask(estimatedBytes)) {
+        task.Reserve(estimatedBytes);
         Work_GetDetachedDispatcher().Run(std::move(task));
         Work_EnsureDetachedTaskProgress();
     }
     else {
-        task();
+        task.Invoke();
     }
 }
 
+/// \overload
+template <class Fn>
+void WorkRunDetachedTask(Fn &&fn)
+{
+    WorkRunDetachedTask(std::forward<Fn>(fn), 0);
+}
+
+/// Limit the detached tasks pending completion to \p maxPendingTasks tasks
+/// and \p maxPendingBytes estimated bytes, where 0 means no limit.
+///
+/// When either limit is reached, WorkRunDetachedTask() and the asynchronous
+/// destruction functions in work/utils.h run their work synchronously, which
+/// bounds the memory held by queued work at the expense of the caller's time.
+/// The initial limits are taken from the PXR_WORK_MAX_PENDING_DETACHED_TASKS
+/// and PXR_WORK_MAX_PENDING_DETACHED_TASK_MB env settings, and default to no
+/// limit.
+WORK_API
+void WorkSetDetachedTaskLimits(size_t maxPendingTasks, size_t maxPendingBytes);
+
+/// Return the number of detached tasks queued, running, or not yet destroyed.
+WORK_API
+size_t WorkGetDetachedTaskQueueDepth();
+
+/// Return the sum of the estimated bytes of detached tasks queued, running, or
+/// not yet destroyed.
+WORK_API
+size_t WorkGetDetachedTaskBytesPending();
+
 }  // namespace pxr
 
 #endif // PXR_WORK_DETACHED_TASK_H
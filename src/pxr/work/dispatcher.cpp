@@ -7,17 +7,41 @@
 
 #include "./dispatcher.h"
 
+#include <pxr/arch/timing.h>
+
 namespace pxr {
 
 WorkDispatcher::WorkDispatcher()
+    : WorkDispatcher(WorkTaskPriority::Normal)
+{
+}
+
+WorkDispatcher::WorkDispatcher(WorkTaskPriority priority)
+    : WorkDispatcher(Work_GetPriorityArena(priority), false)
+{
+}
+
+WorkDispatcher::WorkDispatcher(WorkArena &arena)
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    : WorkDispatcher(&arena._arena, true)
+#else
+    : WorkDispatcher(nullptr, true)
+#endif
+{
+}
+
+WorkDispatcher::WorkDispatcher(tbb::task_arena *arena, bool isArenaCapped)
     : _context(
         tbb::task_group_context::isolated,
         tbb::task_group_context::concurrent_wait | 
         tbb::task_group_context::default_traits)
 #if TBB_INTERFACE_VERSION_MAJOR >= 12
       , _taskGroup(_context)
+      , _arena(arena)
+      , _isArenaCapped(isArenaCapped)
 #endif
       , _isCancelled(false)
+      , _stats(nullptr)
 {
     _waitCleanupFlag.clear();
     
@@ -39,6 +63,18 @@ WorkDispatcher::_TaskGroup::_GetInternalWaitContext() {
     return m_wait_ctx;
 #endif
 }
+
+void
+WorkDispatcher::_ReserveArenaTask()
+{
+    _taskGroup._GetInternalWaitContext().reserve();
+}
+
+void
+WorkDispatcher::_ReleaseArenaTask()
+{
+    _taskGroup._GetInternalWaitContext().release();
+}
 #endif
 
 WorkDispatcher::~WorkDispatcher() noexcept
@@ -48,17 +84,32 @@ WorkDispatcher::~WorkDispatcher() noexcept
 #if TBB_INTERFACE_VERSION_MAJOR < 12
     tbb::task::destroy(*_rootTask);
 #endif
+
+    delete _stats.load(std::memory_order_relaxed);
 }
 
 void
 WorkDispatcher::Wait()
 {
+    const uint64_t startTicks =
+        ARCH_UNLIKELY(WorkAreDispatcherStatsEnabled()) ? ArchGetTickTime() : 0;
+
     // Wait for tasks to complete.
 #if TBB_INTERFACE_VERSION_MAJOR >= 12
     // The native task_group::wait() has a comment saying its call to the
     // context reset method is not thread safe. So we do our own
     // synchronization to ensure it is called once.
-    tbb::detail::d1::wait(_taskGroup._GetInternalWaitContext(), _context);
+    if (_arena) {
+        // Join the dispatcher's arena, to help run its tasks while waiting.
+        _arena->execute([this]() {
+            Work_ScopedCurrentArena scope(_arena);
+            tbb::detail::d1::wait(
+                _taskGroup._GetInternalWaitContext(), _context);
+        });
+    }
+    else {
+        tbb::detail::d1::wait(_taskGroup._GetInternalWaitContext(), _context);
+    }
 #else
     _rootTask->wait_for_all();
 #endif
@@ -78,6 +129,10 @@ WorkDispatcher::Wait()
         _waitCleanupFlag.clear();
         _isCancelled = false;
     }
+
+    if (startTicks) {
+        Work_RecordWait(_GetStatsCounters(), startTicks);
+    }
 }
 
 bool
@@ -86,6 +141,31 @@ WorkDispatcher::IsCancelled() const
     return _isCancelled;
 }
 
+WorkDispatcherStats
+WorkDispatcher::GetStats() const
+{
+    const Work_DispatcherStatsCounters *stats =
+        _stats.load(std::memory_order_acquire);
+    return stats ? stats->Get() : WorkDispatcherStats();
+}
+
+Work_DispatcherStatsCounters *
+WorkDispatcher::_GetStatsCounters()
+{
+    Work_DispatcherStatsCounters *stats =
+        _stats.load(std::memory_order_acquire);
+    if (ARCH_LIKELY(stats)) {
+        return stats;
+    }
+
+    Work_DispatcherStatsCounters *newStats = new Work_DispatcherStatsCounters;
+    if (_stats.compare_exchange_strong(stats, newStats)) {
+        return newStats;
+    }
+    delete newStats;
+    return stats;
+}
+
 void
 WorkDispatcher::Cancel()
 {
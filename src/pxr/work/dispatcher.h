@@ -12,7 +12,13 @@
 
 #include "./threadLimits.h"
 #include "./api.h"
+#include "./arena.h"
+#include "./dispatcherStats.h"
+#include "./future.h"
+#include "./parallelismProfile.h"
+#include "./tracing.h"
 
+#include <pxr/arch/hints.h>
 #include <pxr/tf/errorMark.h>
 #include <pxr/tf/errorTransport.h>
 
@@ -26,7 +32,12 @@
 #include <tbb/task.h>
 #endif
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -62,12 +73,34 @@ namespace pxr {
 /// Additionally, Wait() must never be called by a task added by Run(), since
 /// that task could never complete.
 ///
+/// A dispatcher may be given a WorkTaskPriority, so that its tasks are started
+/// ahead of, or after, tasks of other dispatchers.  Individual tasks may also
+/// be given a priority with RunWithPriority().  A dispatcher may also be given
+/// a WorkArena, to cap the number of threads running its tasks.
+///
+/// Tasks whose result is needed by the caller may be run with
+/// RunWithResult(), which returns a WorkFuture for just that task.
+///
 class WorkDispatcher
 {
 public:
     /// Construct a new dispatcher.
     WORK_API WorkDispatcher();
 
+    /// Construct a new dispatcher whose tasks run with \p priority.
+    ///
+    /// Low and high priority tasks are run by worker threads in an arena
+    /// shared by all tasks of that priority, whereas normal priority tasks
+    /// run in the arena of the thread that calls Run(), which is the default.
+    /// Submitting low or high priority tasks is somewhat more expensive, so
+    /// prefer normal priority for small tasks that are not latency-critical.
+    WORK_API explicit WorkDispatcher(WorkTaskPriority priority);
+
+    /// Construct a new dispatcher whose tasks run in \p arena, which limits
+    /// how many threads run them concurrently.  \p arena must outlive the
+    /// dispatcher.  See WorkArena.
+    WORK_API explicit WorkDispatcher(WorkArena &arena);
+
     /// Wait() for any pending tasks to complete, then destroy the dispatcher.
     WORK_API ~WorkDispatcher() noexcept;
 
@@ -86,6 +119,13 @@ public:
     /// is limited to 1.  The added work may be not yet started, may be started
     /// but not completed, or may be completed upon return.  No guarantee is
     /// made.
+    ///
+    /// The callable and any arguments are moved into the task itself, so
+    /// running small closures requires no allocation beyond the task object,
+    /// which the underlying scheduler takes from its per-thread task pools.
+    /// Arguments are stored by value and passed to \p c as const lvalues, as
+    /// with std::bind.  Unlike std::bind, nested bind expressions and
+    /// placeholders are not interpreted.
     template <class Callable, class A1, class A2, ... class AN>
     void Run(Callable &&c, A1 &&a1, A2 &&a2, ... AN &&aN);
 
@@ -94,7 +134,7 @@ public:
     template <class Callable>
     inline void Run(Callable &&c) {
 #if TBB_INTERFACE_VERSION_MAJOR >= 12
-        _taskGroup.run(_InvokerTask<typename std::remove_reference<Callable>::type>(std::forward<Callable>(c), &_errors));
+        _Run(_arena, _InvokerTask<typename std::remove_reference<Callable>::type>(std::forward<Callable>(c), this));
 #else
         _rootTask->spawn(_MakeInvokerTask(std::forward<Callable>(c)));
 #endif
@@ -102,13 +142,178 @@ public:
 
     template <class Callable, class A0, class ... Args>
     inline void Run(Callable &&c, A0 &&a0, Args&&... args) {
-        Run(std::bind(std::forward<Callable>(c),
-                      std::forward<A0>(a0),
-                      std::forward<Args>(args)...));
+        Run(_BoundTask<typename std::decay<Callable>::type,
+                       typename std::decay<A0>::type,
+                       typename std::decay<Args>::type...>(
+                std::forward<Callable>(c),
+                std::forward<A0>(a0),
+                std::forward<Args>(args)...));
     }
     
 #endif // doxygen
 
+#ifdef doxygen
+
+    /// Like Run(), but do not transport errors posted by the task back to the
+    /// thread that calls Wait().
+    ///
+    /// Run() sets up a TfErrorMark around every task it invokes, so that
+    /// errors can be moved to the waiting thread.  For very small tasks the
+    /// cost of that mark is a measurable fraction of the task itself.  Use this
+    /// function for tasks that are known not to post errors to avoid it.
+    ///
+    /// Errors that are nevertheless posted by such a task are handled as if
+    /// they were posted outside of any task on the executing thread: they are
+    /// reported there, or collected by an unrelated TfErrorMark that happens
+    /// to be active on that thread.  They are never seen by Wait().
+    template <class Callable, class A1, class A2, ... class AN>
+    void RunNoErrorTransport(Callable &&c, A1 &&a1, A2 &&a2, ... AN &&aN);
+
+#else // doxygen
+
+    template <class Callable>
+    inline void RunNoErrorTransport(Callable &&c) {
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+        _Run(_arena, _InvokerTask<
+            typename std::remove_reference<Callable>::type, false>(
+                std::forward<Callable>(c), this));
+#else
+        _rootTask->spawn(
+            _MakeInvokerTask<false>(std::forward<Callable>(c)));
+#endif
+    }
+
+    template <class Callable, class A0, class ... Args>
+    inline void RunNoErrorTransport(Callable &&c, A0 &&a0, Args&&... args) {
+        RunNoErrorTransport(_BoundTask<typename std::decay<Callable>::type,
+                                       typename std::decay<A0>::type,
+                                       typename std::decay<Args>::type...>(
+                std::forward<Callable>(c),
+                std::forward<A0>(a0),
+                std::forward<Args>(args)...));
+    }
+
+#endif // doxygen
+
+#ifdef doxygen
+
+    /// Like Run(), but run the task with \p priority instead of the priority
+    /// of the dispatcher.
+    ///
+    /// If the dispatcher was constructed with a WorkArena, \p priority is
+    /// ignored and the task runs in that arena, with the arena's priority, so
+    /// that it remains subject to the arena's concurrency limit.  \p priority
+    /// is also ignored when there is no concurrency, since the task may then
+    /// only be run by the thread that calls Wait().
+    template <class Callable, class A1, class A2, ... class AN>
+    void RunWithPriority(WorkTaskPriority priority,
+                         Callable &&c, A1 &&a1, A2 &&a2, ... AN &&aN);
+
+#else // doxygen
+
+    template <class Callable>
+    inline void RunWithPriority(WorkTaskPriority priority, Callable &&c) {
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+        _Run(_GetPriorityArena(priority),
+             _InvokerTask<typename std::remove_reference<Callable>::type>(
+                 std::forward<Callable>(c), this));
+#else
+        Run(std::forward<Callable>(c));
+#endif
+    }
+
+    template <class Callable, class A0, class ... Args>
+    inline void RunWithPriority(WorkTaskPriority priority,
+                                Callable &&c, A0 &&a0, Args&&... args) {
+        RunWithPriority(priority,
+            _BoundTask<typename std::decay<Callable>::type,
+                       typename std::decay<A0>::type,
+                       typename std::decay<Args>::type...>(
+                std::forward<Callable>(c),
+                std::forward<A0>(a0),
+                std::forward<Args>(args)...));
+    }
+
+#endif // doxygen
+
+#ifdef doxygen
+
+    /// Like Run(), but return a WorkFuture that provides the result of
+    /// invoking \p c.  Errors posted by the task are transported to the
+    /// thread that retrieves the result from the future, instead of the
+    /// thread that calls Wait().
+    ///
+    /// The task is still part of this dispatcher: Wait() waits for it, and
+    /// Cancel() may prevent it from running, in which case the future
+    /// becomes ready without a result.
+    template <class Callable, class A1, class A2, ... class AN>
+    WorkFuture<R> RunWithResult(Callable &&c, A1 &&a1, A2 &&a2, ... AN &&aN);
+
+#else // doxygen
+
+    template <class Callable>
+    inline auto RunWithResult(Callable &&c) {
+        using Fn = typename std::decay<Callable>::type;
+        using Result = typename std::decay<
+            decltype(std::declval<const Fn &>()())>::type;
+
+        auto state = std::make_shared<Work_FutureState<Result>>();
+        RunNoErrorTransport(Work_FutureTask<Fn, Result>(
+            std::forward<Callable>(c), state));
+        return WorkFuture<Result>(std::move(state));
+    }
+
+    template <class Callable, class A0, class ... Args>
+    inline auto RunWithResult(Callable &&c, A0 &&a0, Args&&... args) {
+        return RunWithResult(_BoundTask<typename std::decay<Callable>::type,
+                                        typename std::decay<A0>::type,
+                                        typename std::decay<Args>::type...>(
+                std::forward<Callable>(c),
+                std::forward<A0>(a0),
+                std::forward<Args>(args)...));
+    }
+
+#endif // doxygen
+
+    /// Add \p n tasks for the dispatcher to run, invoking \p c with each index
+    /// in [0, \p n).
+    ///
+    /// This is equivalent to invoking Run() \p n times, but only a single task
+    /// is submitted by the caller.  That task recursively splits the index
+    /// range, submitting the upper half as a new task and continuing with the
+    /// lower half, so the fan-out itself runs in parallel.  \p c is copied into
+    /// each task and must be invocable as a const object.
+    ///
+    /// Callable must be of the form:
+    ///
+    ///     void Callable(size_t i);
+    ///
+    /// The same restrictions on calling Run() apply.
+    template <class Callable>
+    inline void RunN(size_t n, Callable &&c) {
+        if (n != 0) {
+            Run(_RangeTask<typename std::decay<Callable>::type>(
+                    this, std::forward<Callable>(c), 0, n));
+        }
+    }
+
+    /// Add a task for each element in [\p first, \p last), invoking \p c with
+    /// that element.  \p first and \p last must be random access iterators
+    /// that remain valid until the tasks complete.  See RunN() for details.
+    ///
+    /// Callable must be of the form:
+    ///
+    ///     void Callable(T elem);
+    ///
+    /// where the type T is deduced from the type of the iterator.
+    template <class Iterator, class Callable>
+    inline void RunBatch(Iterator first, Iterator last, Callable &&c) {
+        RunN(std::distance(first, last),
+             [first, c = std::forward<Callable>(c)](size_t i) {
+                 c(first[i]);
+             });
+    }
+
     /// Block until the work started by Run() completes.
     WORK_API void Wait();
 
@@ -128,20 +333,77 @@ public:
     /// cancel state.
     WORK_API bool IsCancelled() const;
 
+    /// Return the statistics of the tasks run by this dispatcher while
+    /// statistics collection was enabled.  See WorkDispatcherStats.
+    WORK_API WorkDispatcherStats GetStats() const;
+
 private:
+    // Construct a dispatcher that runs tasks in arena, or in the arena of the
+    // thread that calls Run() if arena is null.  If isArenaCapped is true,
+    // arena belongs to a WorkArena, and all tasks run in it regardless of
+    // their priority.
+    WORK_API WorkDispatcher(tbb::task_arena *arena, bool isArenaCapped);
+
     typedef tbb::concurrent_vector<TfErrorTransport> _ErrorTransports;
 
+    // Callable that stores a function and its arguments in place, used to
+    // implement the variadic Run() without going through std::bind.
+    template <class Fn, class ... Args>
+    struct _BoundTask {
+        explicit _BoundTask(Fn fn, Args... args)
+            : _fn(std::move(fn)), _args(std::move(args)...) {}
+
+        decltype(auto) operator()() const {
+            return std::apply(_fn, _args);
+        }
+    private:
+        Fn _fn;
+        std::tuple<Args...> _args;
+    };
+
+    // Task that invokes a function over an index range for RunN(), splitting
+    // off the upper half of the range as new tasks until one index remains.
+    template <class Fn>
+    struct _RangeTask {
+        template <class F>
+        _RangeTask(WorkDispatcher *d, F &&fn, size_t begin, size_t end)
+            : _dispatcher(d), _fn(std::forward<F>(fn))
+            , _begin(begin), _end(end) {}
+
+        void operator()() const {
+            size_t end = _end;
+            while (end - _begin > 1) {
+                const size_t mid = _begin + (end - _begin) / 2;
+                _dispatcher->Run(_RangeTask(_dispatcher, _fn, mid, end));
+                end = mid;
+            }
+            _fn(_begin);
+        }
+    private:
+        WorkDispatcher *_dispatcher;
+        Fn _fn;
+        size_t _begin;
+        size_t _end;
+    };
+
     // Function invoker helper that wraps the invocation with an ErrorMark so we
     // can transmit errors that occur back to the thread that Wait() s for tasks
-    // to complete.
+    // to complete.  The mark is omitted if TransportErrors is false.  If
+    // statistics are enabled when the task is submitted, the task also records
+    // when it starts and completes, and if it is submitted within a profiled
+    // parallelism region, the time it runs is attributed to that region.
 #if TBB_INTERFACE_VERSION_MAJOR >= 12
-    template <class Fn>
+    template <class Fn, bool TransportErrors = true>
     struct _InvokerTask {
-        explicit _InvokerTask(Fn &&fn, _ErrorTransports *err) 
-            : _fn(std::move(fn)), _errors(err) {}
+        explicit _InvokerTask(Fn &&fn, WorkDispatcher *d)
+            : _fn(std::move(fn)), _dispatcher(d)
+            , _submitTicks(d->_RecordSubmitted())
+            , _region(Work_GetParallelismRegion()) {}
 
-        explicit _InvokerTask(Fn const &fn, _ErrorTransports *err) 
-            : _fn(fn), _errors(err) {}
+        explicit _InvokerTask(Fn const &fn, WorkDispatcher *d)
+            : _fn(fn), _dispatcher(d)
+            , _submitTicks(d->_RecordSubmitted())
+            , _region(Work_GetParallelismRegion()) {}
 
         // Ensure only moves happen, no copies.
         _InvokerTask(_InvokerTask &&other) = default;
@@ -149,48 +411,180 @@ private:
         _InvokerTask &operator=(const _InvokerTask &other) = delete;
 
         void operator()() const {
-            TfErrorMark m;
-            _fn();
-            if (!m.IsClean())
-                WorkDispatcher::_TransportErrors(m, _errors);
+            if (ARCH_UNLIKELY(_submitTicks)) {
+                Work_DispatcherStatsCounters *stats =
+                    _dispatcher->_GetStatsCounters();
+                const uint64_t startTicks =
+                    Work_RecordTaskStarted(stats, _submitTicks);
+                _Invoke();
+                Work_RecordTaskCompleted(stats, startTicks);
+            }
+            else {
+                _Invoke();
+            }
         }
     private:
+        void _Invoke() const {
+            WORK_TRACE_SCOPE("WorkDispatcher task");
+            Work_ParallelismTaskScope regionScope(_region.Get());
+            if constexpr (TransportErrors) {
+                TfErrorMark m;
+                _fn();
+                if (!m.IsClean())
+                    WorkDispatcher::_TransportErrors(
+                        m, &_dispatcher->_errors);
+            }
+            else {
+                _fn();
+            }
+        }
+
         Fn _fn;
-        _ErrorTransports *_errors;
+        WorkDispatcher *_dispatcher;
+        uint64_t _submitTicks;
+        Work_ParallelismRegionRef _region;
     };
 #else
-    template <class Fn>
+    template <class Fn, bool TransportErrors = true>
     struct _InvokerTask : public tbb::task {
-        explicit _InvokerTask(Fn &&fn, _ErrorTransports *err)
-            : _fn(std::move(fn)), _errors(err) {}
+        explicit _InvokerTask(Fn &&fn, WorkDispatcher *d)
+            : _fn(std::move(fn)), _dispatcher(d)
+            , _submitTicks(d->_RecordSubmitted())
+            , _region(Work_GetParallelismRegion()) {}
 
-        explicit _InvokerTask(Fn const &fn, _ErrorTransports *err)
-            : _fn(fn), _errors(err) {}
+        explicit _InvokerTask(Fn const &fn, WorkDispatcher *d)
+            : _fn(fn), _dispatcher(d)
+            , _submitTicks(d->_RecordSubmitted())
+            , _region(Work_GetParallelismRegion()) {}
 
         virtual tbb::task* execute() {
-            TfErrorMark m;
-            // In anticipation of OneTBB, ensure that _fn meets OneTBB's
-            // requirement that a task's call operator must be const.
-            const_cast<_InvokerTask const *>(this)->_fn();
-            if (!m.IsClean())
-                WorkDispatcher::_TransportErrors(m, _errors);
+            if (ARCH_UNLIKELY(_submitTicks)) {
+                Work_DispatcherStatsCounters *stats =
+                    _dispatcher->_GetStatsCounters();
+                const uint64_t startTicks =
+                    Work_RecordTaskStarted(stats, _submitTicks);
+                _Invoke();
+                Work_RecordTaskCompleted(stats, startTicks);
+            }
+            else {
+                _Invoke();
+            }
             return NULL;
         }
     private:
+        void _Invoke() {
+            WORK_TRACE_SCOPE("WorkDispatcher task");
+            Work_ParallelismTaskScope regionScope(_region.Get());
+            // In anticipation of OneTBB, ensure that _fn meets OneTBB's
+            // requirement that a task's call operator must be const.
+            if constexpr (TransportErrors) {
+                TfErrorMark m;
+                const_cast<_InvokerTask const *>(this)->_fn();
+                if (!m.IsClean())
+                    WorkDispatcher::_TransportErrors(
+                        m, &_dispatcher->_errors);
+            }
+            else {
+                const_cast<_InvokerTask const *>(this)->_fn();
+            }
+        }
+
         Fn _fn;
-        _ErrorTransports *_errors;
+        WorkDispatcher *_dispatcher;
+        uint64_t _submitTicks;
+        Work_ParallelismRegionRef _region;
     };
 
     // Make an _InvokerTask instance, letting the function template deduce Fn.
-    template <class Fn>
-    _InvokerTask<typename std::remove_reference<Fn>::type>&
+    template <bool TransportErrors = true, class Fn>
+    _InvokerTask<typename std::remove_reference<Fn>::type, TransportErrors>&
     _MakeInvokerTask(Fn &&fn) { 
         return *new( _rootTask->allocate_additional_child_of(*_rootTask) )
-            _InvokerTask<typename std::remove_reference<Fn>::type>(
-                std::forward<Fn>(fn), &_errors);
+            _InvokerTask<typename std::remove_reference<Fn>::type,
+                         TransportErrors>(
+                std::forward<Fn>(fn), this);
     }
 #endif
 
+    // Record the submission of a task if statistics are enabled, and return
+    // the time of submission in ticks, or 0 otherwise.
+    inline uint64_t _RecordSubmitted() {
+        if (ARCH_LIKELY(!Work_DispatcherStatsEnabled.load(
+                std::memory_order_relaxed))) {
+            return 0;
+        }
+        return Work_RecordTaskSubmitted(_GetStatsCounters());
+    }
+
+    // Return the statistics counters of this dispatcher, creating them on
+    // first use.
+    WORK_API Work_DispatcherStatsCounters *_GetStatsCounters();
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    // Task that records the arena it runs in while it runs, so that the
+    // tasks it adds to that arena can be run directly in the task group.
+    template <class Task>
+    struct _InArenaTask {
+        void operator()() const {
+            Work_ScopedCurrentArena scope(arena);
+            task();
+        }
+
+        tbb::task_arena *arena;
+        Task task;
+    };
+
+    // Task enqueued in another arena, that runs its task in the dispatcher's
+    // task group from there.  The enqueued task is invoked once, as a const
+    // object, so the wrapped task is mutable to be moved into the group.
+    template <class Task>
+    struct _ArenaTask {
+        void operator()() const {
+            dispatcher->_taskGroup.run(
+                _InArenaTask<Task> { arena, std::move(task) });
+            dispatcher->_ReleaseArenaTask();
+        }
+
+        WorkDispatcher *dispatcher;
+        tbb::task_arena *arena;
+        mutable Task task;
+    };
+
+    // Run task in arena, or in the current arena if arena is null.
+    template <class Task>
+    inline void _Run(tbb::task_arena *arena, Task &&task) {
+        using _Task = typename std::remove_reference<Task>::type;
+        if (ARCH_LIKELY(!arena)) {
+            _taskGroup.run(std::move(task));
+        }
+        else if (arena == Work_GetCurrentArena()) {
+            // Already running in arena, such as in a task of this dispatcher
+            // or a split of RunN(), so spawn the task directly rather than
+            // going through the arena's queue.
+            _taskGroup.run(_InArenaTask<_Task> { arena, std::move(task) });
+        }
+        else {
+            // Account for the task until it is added to the task group, so
+            // that Wait() cannot return before it runs.
+            _ReserveArenaTask();
+            arena->enqueue(_ArenaTask<_Task> { this, arena, std::move(task) });
+        }
+    }
+
+    // Return the arena to run tasks given priority in.  Wait() only joins
+    // _arena, so tasks sent to any other arena are left to worker threads.
+    // Without concurrency there may be none, so run them in _arena instead.
+    inline tbb::task_arena *_GetPriorityArena(WorkTaskPriority priority) {
+        if (_isArenaCapped || !WorkHasConcurrency()) {
+            return _arena;
+        }
+        return Work_GetPriorityArena(priority);
+    }
+
+    WORK_API void _ReserveArenaTask();
+    WORK_API void _ReleaseArenaTask();
+#endif
+
     // Helper function that removes errors from \p m and stores them in a new
     // entry in \p errors.
     WORK_API static void
@@ -207,6 +601,13 @@ private:
     };
 
     _TaskGroup _taskGroup;
+
+    // Arena to run tasks in, or null to run them in the arena of the thread
+    // that calls Run().
+    tbb::task_arena *_arena;
+
+    // Whether _arena belongs to a WorkArena, rather than to a priority.
+    bool _isArenaCapped;
 #else
     // Root task that allows us to cancel tasks invoked directly by this
     // dispatcher.
@@ -220,6 +621,9 @@ private:
 
     // Concurrent calls to Wait() have to serialize certain cleanup operations.
     std::atomic_flag _waitCleanupFlag;
+
+    // Statistics counters, allocated when statistics are first recorded.
+    std::atomic<Work_DispatcherStatsCounters *> _stats;
 };
 
 // Wrapper class for non-const tasks.
@@ -0,0 +1,152 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./dispatcherStats.h"
+
+#include <pxr/arch/timing.h>
+#include <pxr/tf/envSetting.h>
+
+#include <algorithm>
+
+TF_DEFINE_ENV_SETTING(
+    PXR_WORK_DISPATCHER_STATS, false,
+    "Collect statistics about the tasks run by WorkDispatcher instances. "
+    "See WorkDispatcherStats.");
+
+namespace pxr {
+
+std::atomic<bool> Work_DispatcherStatsEnabled {
+    TfGetEnvSetting(PXR_WORK_DISPATCHER_STATS) };
+
+static Work_DispatcherStatsCounters &
+_GetProcessCounters()
+{
+    static Work_DispatcherStatsCounters *counters =
+        new Work_DispatcherStatsCounters;
+    return *counters;
+}
+
+// Return the histogram bucket of a duration in ticks.
+static size_t
+_GetBucket(uint64_t ticks)
+{
+    const uint64_t nanoseconds =
+        std::max<int64_t>(0, ArchTicksToNanoseconds(ticks));
+    size_t bucket = 0;
+    for (uint64_t d = nanoseconds; d != 0; d >>= 1) {
+        ++bucket;
+    }
+    return std::min(bucket, WorkDispatcherStats::NumBuckets - 1);
+}
+
+WorkDispatcherStats
+Work_DispatcherStatsCounters::Get() const
+{
+    WorkDispatcherStats stats;
+    stats.numTasksSubmitted = numTasksSubmitted.load(std::memory_order_relaxed);
+    stats.numTasksStarted = numTasksStarted.load(std::memory_order_relaxed);
+    stats.numTasksCompleted = numTasksCompleted.load(std::memory_order_relaxed);
+    stats.numWaits = numWaits.load(std::memory_order_relaxed);
+    stats.waitNanoseconds = waitNanoseconds.load(std::memory_order_relaxed);
+    for (size_t i = 0; i != WorkDispatcherStats::NumBuckets; ++i) {
+        stats.queueNanosecondsHistogram[i] =
+            queueNanosecondsHistogram[i].load(std::memory_order_relaxed);
+        stats.runNanosecondsHistogram[i] =
+            runNanosecondsHistogram[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void
+Work_DispatcherStatsCounters::Reset()
+{
+    numTasksSubmitted.store(0, std::memory_order_relaxed);
+    numTasksStarted.store(0, std::memory_order_relaxed);
+    numTasksCompleted.store(0, std::memory_order_relaxed);
+    numWaits.store(0, std::memory_order_relaxed);
+    waitNanoseconds.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i != WorkDispatcherStats::NumBuckets; ++i) {
+        queueNanosecondsHistogram[i].store(0, std::memory_order_relaxed);
+        runNanosecondsHistogram[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+bool
+WorkAreDispatcherStatsEnabled()
+{
+    return Work_DispatcherStatsEnabled.load(std::memory_order_relaxed);
+}
+
+void
+WorkSetDispatcherStatsEnabled(bool enabled)
+{
+    Work_DispatcherStatsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+WorkDispatcherStats
+WorkGetDispatcherStats()
+{
+    return _GetProcessCounters().Get();
+}
+
+void
+WorkResetDispatcherStats()
+{
+    _GetProcessCounters().Reset();
+}
+
+uint64_t
+Work_RecordTaskSubmitted(Work_DispatcherStatsCounters *counters)
+{
+    counters->numTasksSubmitted.fetch_add(1, std::memory_order_relaxed);
+    _GetProcessCounters().numTasksSubmitted.fetch_add(
+        1, std::memory_order_relaxed);
+    return ArchGetTickTime();
+}
+
+uint64_t
+Work_RecordTaskStarted(
+    Work_DispatcherStatsCounters *counters, uint64_t submitTicks)
+{
+    const uint64_t ticks = ArchGetTickTime();
+    const size_t bucket = _GetBucket(ticks - submitTicks);
+    Work_DispatcherStatsCounters &process = _GetProcessCounters();
+    counters->numTasksStarted.fetch_add(1, std::memory_order_relaxed);
+    counters->queueNanosecondsHistogram[bucket].fetch_add(
+        1, std::memory_order_relaxed);
+    process.numTasksStarted.fetch_add(1, std::memory_order_relaxed);
+    process.queueNanosecondsHistogram[bucket].fetch_add(
+        1, std::memory_order_relaxed);
+    return ticks;
+}
+
+void
+Work_RecordTaskCompleted(
+    Work_DispatcherStatsCounters *counters, uint64_t startTicks)
+{
+    const size_t bucket = _GetBucket(ArchGetTickTime() - startTicks);
+    Work_DispatcherStatsCounters &process = _GetProcessCounters();
+    counters->numTasksCompleted.fetch_add(1, std::memory_order_relaxed);
+    counters->runNanosecondsHistogram[bucket].fetch_add(
+        1, std::memory_order_relaxed);
+    process.numTasksCompleted.fetch_add(1, std::memory_order_relaxed);
+    process.runNanosecondsHistogram[bucket].fetch_add(
+        1, std::memory_order_relaxed);
+}
+
+void
+Work_RecordWait(Work_DispatcherStatsCounters *counters, uint64_t startTicks)
+{
+    const uint64_t nanoseconds = std::max<int64_t>(
+        0, ArchTicksToNanoseconds(ArchGetTickTime() - startTicks));
+    Work_DispatcherStatsCounters &process = _GetProcessCounters();
+    counters->numWaits.fetch_add(1, std::memory_order_relaxed);
+    counters->waitNanoseconds.fetch_add(
+        nanoseconds, std::memory_order_relaxed);
+    process.numWaits.fetch_add(1, std::memory_order_relaxed);
+    process.waitNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+}  // namespace pxr
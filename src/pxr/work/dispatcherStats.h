@@ -0,0 +1,128 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_DISPATCHER_STATS_H
+#define PXR_WORK_DISPATCHER_STATS_H
+
+/// \file work/dispatcherStats.h
+
+#include "./api.h"
+
+#include <pxr/arch/hints.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace pxr {
+
+/// \struct WorkDispatcherStats
+///
+/// Statistics about the tasks run by WorkDispatcher instances, collected
+/// while WorkAreDispatcherStatsEnabled() is true.
+///
+/// Statistics are kept for each dispatcher, see WorkDispatcher::GetStats(),
+/// and for all dispatchers in the process, see WorkGetDispatcherStats().
+/// Collecting them costs a few atomic operations and two clock reads per
+/// task, and one check of a global flag per task when disabled, so it may be
+/// left enabled in production.
+///
+/// Durations are recorded in histograms with logarithmic buckets: bucket
+/// \c i counts durations \c d such that 2^(i-1) <= d < 2^i nanoseconds, bucket
+/// 0 counts durations shorter than a nanosecond, and the last bucket also
+/// counts all longer durations.
+///
+struct WorkDispatcherStats
+{
+    /// Number of histogram buckets.
+    static constexpr size_t NumBuckets = 32;
+
+    using Histogram = std::array<size_t, NumBuckets>;
+
+    /// Number of tasks added with Run() and its variants.
+    size_t numTasksSubmitted = 0;
+
+    /// Number of tasks that started running.  Tasks that are cancelled before
+    /// running are never started.
+    size_t numTasksStarted = 0;
+
+    /// Number of tasks that finished running.
+    size_t numTasksCompleted = 0;
+
+    /// Number of calls to WorkDispatcher::Wait().
+    size_t numWaits = 0;
+
+    /// Total time spent in WorkDispatcher::Wait(), in nanoseconds.  This
+    /// includes time spent running tasks on behalf of the dispatcher while
+    /// waiting.
+    uint64_t waitNanoseconds = 0;
+
+    /// Histogram of the time between the submission of tasks and the start
+    /// of their execution.
+    Histogram queueNanosecondsHistogram = {};
+
+    /// Histogram of the time spent running tasks.
+    Histogram runNanosecondsHistogram = {};
+};
+
+/// Return true if dispatcher statistics are being collected.  This defaults
+/// to the value of the PXR_WORK_DISPATCHER_STATS environment variable.
+WORK_API bool WorkAreDispatcherStatsEnabled();
+
+/// Enable or disable the collection of dispatcher statistics.  Tasks submitted
+/// while collection is disabled are not accounted for.
+WORK_API void WorkSetDispatcherStatsEnabled(bool enabled);
+
+/// Return the statistics of all dispatchers in this process since collection
+/// was first enabled, or since the last call to WorkResetDispatcherStats().
+WORK_API WorkDispatcherStats WorkGetDispatcherStats();
+
+/// Reset the statistics returned by WorkGetDispatcherStats().
+WORK_API void WorkResetDispatcherStats();
+
+// Whether statistics are collected, read on every task submission.
+extern WORK_API std::atomic<bool> Work_DispatcherStatsEnabled;
+
+// Counters backing a WorkDispatcherStats.
+struct Work_DispatcherStatsCounters
+{
+    std::atomic<size_t> numTasksSubmitted {0};
+    std::atomic<size_t> numTasksStarted {0};
+    std::atomic<size_t> numTasksCompleted {0};
+    std::atomic<size_t> numWaits {0};
+    std::atomic<uint64_t> waitNanoseconds {0};
+    std::atomic<size_t> queueNanosecondsHistogram[
+        WorkDispatcherStats::NumBuckets] = {};
+    std::atomic<size_t> runNanosecondsHistogram[
+        WorkDispatcherStats::NumBuckets] = {};
+
+    WORK_API WorkDispatcherStats Get() const;
+    WORK_API void Reset();
+};
+
+// Record a task submission in counters, and in the process-wide counters.
+// Return the current time in ticks.
+WORK_API uint64_t
+Work_RecordTaskSubmitted(Work_DispatcherStatsCounters *counters);
+
+// Record that a task submitted at submitTicks started, and return the current
+// time in ticks.
+WORK_API uint64_t
+Work_RecordTaskStarted(
+    Work_DispatcherStatsCounters *counters, uint64_t submitTicks);
+
+// Record that a task started at startTicks completed.
+WORK_API void
+Work_RecordTaskCompleted(
+    Work_DispatcherStatsCounters *counters, uint64_t startTicks);
+
+// Record a call to Wait() that started at startTicks.
+WORK_API void
+Work_RecordWait(Work_DispatcherStatsCounters *counters, uint64_t startTicks);
+
+}  // namespace pxr
+
+#endif // PXR_WORK_DISPATCHER_STATS_H
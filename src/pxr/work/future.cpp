@@ -0,0 +1,111 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./future.h"
+
+namespace pxr {
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+// Context to wait on future states in.  Tasks run while waiting belong to
+// their own dispatcher's context, so this is only needed by the scheduler's
+// wait loop and can be shared by all waiting threads.
+static tbb::task_group_context &
+_GetWaitContext()
+{
+    static tbb::task_group_context *context = new tbb::task_group_context(
+        tbb::task_group_context::isolated,
+        tbb::task_group_context::concurrent_wait |
+        tbb::task_group_context::default_traits);
+    return *context;
+}
+#endif
+
+Work_FutureStateBase::Work_FutureStateBase()
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    : _waitContext(1)
+    , _ready(false)
+#else
+    : _ready(false)
+#endif
+    , _errorsPosted(false)
+    , _cancelled(false)
+{
+}
+
+Work_FutureStateBase::~Work_FutureStateBase() = default;
+
+void
+Work_FutureStateBase::Wait()
+{
+    if (IsReady()) {
+        return;
+    }
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    tbb::detail::d1::wait(_waitContext, _GetWaitContext());
+#else
+    // Legacy TBB cannot wait on an arbitrary condition while executing other
+    // tasks, so block until the task completes.  See WorkFuture.
+    std::unique_lock<std::mutex> lock(_waitMutex);
+    _waitCondition.wait(lock, [this]() { return IsReady(); });
+#endif
+}
+
+void
+Work_FutureStateBase::PostErrors()
+{
+    if (!_errorsPosted.exchange(true)) {
+        _errors.Post();
+    }
+}
+
+void
+Work_FutureStateBase::AddContinuation(std::function<void ()> &&fn)
+{
+    {
+        tbb::spin_mutex::scoped_lock lock(_continuationsMutex);
+        if (!IsReady()) {
+            _continuations.push_back(std::move(fn));
+            return;
+        }
+    }
+    fn();
+}
+
+void
+Work_FutureStateBase::_Complete(const TfErrorMark &m)
+{
+    if (!m.IsClean()) {
+        TfErrorTransport transport = m.Transport();
+        _errors.swap(transport);
+    }
+    _Complete();
+}
+
+void
+Work_FutureStateBase::_Complete()
+{
+    std::vector<std::function<void ()>> continuations;
+    {
+        tbb::spin_mutex::scoped_lock lock(_continuationsMutex);
+        _ready.store(true, std::memory_order_release);
+        continuations.swap(_continuations);
+    }
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    _waitContext.release();
+#else
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+    }
+    _waitCondition.notify_all();
+#endif
+
+    for (const std::function<void ()> &fn : continuations) {
+        fn();
+    }
+}
+
+}  // namespace pxr
@@ -0,0 +1,306 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_FUTURE_H
+#define PXR_WORK_FUTURE_H
+
+/// \file work/future.h
+
+#include "./api.h"
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+#include <pxr/tf/errorTransport.h>
+
+// Blocked range is not used in this file, but this header happens to pull in
+// the TBB version header in a way that works in all TBB versions.
+#include <tbb/blocked_range.h>
+#include <tbb/spin_mutex.h>
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+#include <tbb/task_group.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pxr {
+
+class WorkDispatcher;
+
+// State shared between a WorkFuture and the task that produces its result.
+// The state is completed exactly once, either when the task has run or when
+// the task is destroyed without running because its dispatcher was
+// cancelled.
+class Work_FutureStateBase
+{
+public:
+    WORK_API Work_FutureStateBase();
+    WORK_API ~Work_FutureStateBase();
+
+    Work_FutureStateBase(Work_FutureStateBase const &) = delete;
+    Work_FutureStateBase &operator=(Work_FutureStateBase const &) = delete;
+
+    bool IsReady() const {
+        return _ready.load(std::memory_order_acquire);
+    }
+
+    bool IsCancelled() const {
+        return _cancelled;
+    }
+
+    // Block until the state is complete, executing other pending tasks in
+    // the meantime.
+    WORK_API void Wait();
+
+    // Post the errors transported from the task to this thread, the first
+    // time this is called.
+    WORK_API void PostErrors();
+
+    // Invoke fn once the state is complete, on the thread that completes it,
+    // or immediately if it is already complete.
+    WORK_API void AddContinuation(std::function<void ()> &&fn);
+
+    // Complete the state without a result.
+    void Cancel() {
+        _cancelled = true;
+        _Complete();
+    }
+
+protected:
+    // Take the errors posted since m was set, and complete the state.
+    WORK_API void _Complete(const TfErrorMark &m);
+
+    WORK_API void _Complete();
+
+private:
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    tbb::detail::d1::wait_context _waitContext;
+#else
+    std::mutex _waitMutex;
+    std::condition_variable _waitCondition;
+#endif
+    std::atomic<bool> _ready;
+    std::atomic<bool> _errorsPosted;
+    bool _cancelled;
+    TfErrorTransport _errors;
+
+    tbb::spin_mutex _continuationsMutex;
+    std::vector<std::function<void ()>> _continuations;
+};
+
+template <class T>
+class Work_FutureState : public Work_FutureStateBase
+{
+public:
+    template <class Fn>
+    void Invoke(const Fn &fn) {
+        TfErrorMark m;
+        _value.emplace(fn());
+        _Complete(m);
+    }
+
+    void SetValue(T value) {
+        _value.emplace(std::move(value));
+        _Complete();
+    }
+
+    const T &GetValue() const {
+        return *_value;
+    }
+
+private:
+    std::optional<T> _value;
+};
+
+template <>
+class Work_FutureState<void> : public Work_FutureStateBase
+{
+public:
+    template <class Fn>
+    void Invoke(const Fn &fn) {
+        TfErrorMark m;
+        fn();
+        _Complete(m);
+    }
+
+    void SetValue() {
+        _Complete();
+    }
+
+    void GetValue() const {}
+};
+
+// Task that invokes a function and stores its result in a future state.  If
+// the task is destroyed without having run, because its dispatcher was
+// cancelled, the state is completed as cancelled so waiters are released.
+template <class Fn, class T>
+struct Work_FutureTask {
+    template <class F>
+    Work_FutureTask(F &&fn, std::shared_ptr<Work_FutureState<T>> state)
+        : _fn(std::forward<F>(fn)), _state(std::move(state)) {}
+
+    // Ensure only moves happen, no copies.
+    Work_FutureTask(Work_FutureTask &&other) = default;
+    Work_FutureTask(const Work_FutureTask &other) = delete;
+    Work_FutureTask &operator=(const Work_FutureTask &other) = delete;
+
+    ~Work_FutureTask() {
+        if (_state && !_state->IsReady()) {
+            _state->Cancel();
+        }
+    }
+
+    void operator()() const {
+        _state->Invoke(_fn);
+    }
+
+private:
+    Fn _fn;
+    std::shared_ptr<Work_FutureState<T>> _state;
+};
+
+template <class T>
+class WorkFuture;
+
+template <class T>
+WorkFuture<void> WorkWhenAll(const std::vector<WorkFuture<T>> &futures);
+
+template <class T>
+WorkFuture<size_t> WorkWhenAny(const std::vector<WorkFuture<T>> &futures);
+
+/// \class WorkFuture
+///
+/// A WorkFuture provides the result of a single task run by
+/// WorkDispatcher::RunWithResult().
+///
+/// Unlike WorkDispatcher::Wait(), waiting on a future only waits for its own
+/// task, not for every task of the dispatcher.  While the result is not
+/// available, the waiting thread executes other pending tasks rather than
+/// blocking idle.  Futures may therefore be waited on from within tasks run
+/// by the same dispatcher.  This requires oneTBB: with older versions of TBB,
+/// the waiting thread blocks until the task completes, so futures must not
+/// be waited on from within tasks, which could leave no thread to run it.
+///
+/// For example,
+///
+/// \code
+/// WorkDispatcher dispatcher;
+/// WorkFuture<Mesh> mesh = dispatcher.RunWithResult(LoadMesh, path);
+/// WorkFuture<Texture> texture = dispatcher.RunWithResult(LoadTexture, path);
+/// Draw(mesh.Get(), texture.Get());
+/// \endcode
+///
+/// Errors posted by the task are transported to the first thread that calls
+/// Get() or Wait() once the task completes, rather than to the thread that
+/// waits on the dispatcher.  Futures are cheap to copy, and all copies refer
+/// to the same result.  The dispatcher that runs the task must outlive calls
+/// to Get() and Wait().
+///
+template <class T>
+class WorkFuture
+{
+public:
+    /// Construct an invalid future, not associated with any task.
+    WorkFuture() = default;
+
+    /// Return true if this future is associated with a task.
+    bool IsValid() const {
+        return bool(_state);
+    }
+
+    /// Return true if the task completed, or was cancelled, so that Wait()
+    /// would not block.
+    bool IsReady() const {
+        return _state->IsReady();
+    }
+
+    /// Wait for the task to complete, and return true if it ran, or false if
+    /// it was cancelled before running.
+    bool Wait() const {
+        _state->Wait();
+        _state->PostErrors();
+        return !_state->IsCancelled();
+    }
+
+    /// Wait for the task to complete and return its result.  It is a fatal
+    /// error to call this if the task was cancelled before running.
+    decltype(auto) Get() const {
+        if (!Wait()) {
+            TF_FATAL_ERROR("Getting the result of a cancelled task");
+        }
+        return _state->GetValue();
+    }
+
+private:
+    friend class WorkDispatcher;
+
+    template <class U>
+    friend WorkFuture<void> WorkWhenAll(const std::vector<WorkFuture<U>> &);
+
+    template <class U>
+    friend WorkFuture<size_t> WorkWhenAny(const std::vector<WorkFuture<U>> &);
+
+    explicit WorkFuture(std::shared_ptr<Work_FutureState<T>> state)
+        : _state(std::move(state)) {}
+
+    std::shared_ptr<Work_FutureState<T>> _state;
+};
+
+/// Return a future that is ready once all of \p futures are ready.  Errors
+/// posted by the tasks are not transported to the returned future, and must
+/// be retrieved from each of \p futures.
+template <class T>
+WorkFuture<void>
+WorkWhenAll(const std::vector<WorkFuture<T>> &futures)
+{
+    auto all = std::make_shared<Work_FutureState<void>>();
+    auto remaining = std::make_shared<std::atomic<size_t>>(futures.size() + 1);
+    const auto onReady = [all, remaining]() {
+        if (remaining->fetch_sub(1) == 1) {
+            all->SetValue();
+        }
+    };
+    for (const WorkFuture<T> &future : futures) {
+        future._state->AddContinuation(onReady);
+    }
+    onReady();
+    return WorkFuture<void>(std::move(all));
+}
+
+/// Return a future whose result is the index of the first of \p futures to
+/// become ready.  If \p futures is empty, the returned future is cancelled.
+template <class T>
+WorkFuture<size_t>
+WorkWhenAny(const std::vector<WorkFuture<T>> &futures)
+{
+    auto any = std::make_shared<Work_FutureState<size_t>>();
+    if (futures.empty()) {
+        any->Cancel();
+        return WorkFuture<size_t>(std::move(any));
+    }
+
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    for (size_t i = 0; i != futures.size(); ++i) {
+        futures[i]._state->AddContinuation([any, done, i]() {
+            if (!done->exchange(true)) {
+                any->SetValue(i);
+            }
+        });
+    }
+    return WorkFuture<size_t>(std::move(any));
+}
+
+}  // namespace pxr
+
+#endif // PXR_WORK_FUTURE_H
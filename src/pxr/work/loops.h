@@ -11,12 +11,21 @@
 /// \file work/loops.h
 #include "./threadLimits.h"
 #include "./api.h"
+#include "./cancellation.h"
+#include "./parallelismProfile.h"
+#include "./partitioner.h"
+#include "./tracing.h"
+
+#include <pxr/arch/timing.h>
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/task_group.h>
 
+#include <algorithm>
+#include <cstdint>
+
 namespace pxr {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -38,37 +47,30 @@ WorkSerialForN(size_t n, Fn &&fn)
     std::forward<Fn>(fn)(0, n);
 }
 
-///////////////////////////////////////////////////////////////////////////////
-///
-/// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize = 1)
-///
-/// Runs \p callback in parallel over the range 0 to n.
-///
-/// Callback must be of the form:
-///
-///     void LoopCallback(size_t begin, size_t end);
-///
-/// grainSize specifies a minimum amount of work to be done per-thread. There
-/// is overhead to launching a thread (or task) and a typical guideline is that
-/// you want to have at least 10,000 instructions to count for the overhead of
-/// launching a thread.
-///
-template <typename Fn>
+// Runs WorkParallelForN() using the given TBB partitioner.
+template <typename Fn, typename Partitioner>
 void
-WorkParallelForN(size_t n, Fn &&callback, size_t grainSize)
+Work_ParallelForN(
+    size_t n, Fn &&callback, size_t grainSize, Partitioner &&partitioner)
 {
     if (n == 0)
         return;
 
+    WORK_TRACE_SCOPE("WorkParallelForN");
+
     // Don't bother with parallel_for, if concurrency is limited to 1.
     if (WorkHasConcurrency()) {
 
         class Work_ParallelForN_TBB 
         {
         public:
-            Work_ParallelForN_TBB(Fn &fn) : _fn(fn) { }
+            Work_ParallelForN_TBB(Fn &fn)
+                : _fn(fn), _region(Work_GetParallelismRegion()) { }
 
             void operator()(const tbb::blocked_range<size_t> &r) const {
+                WORK_TRACE_RANGE_SCOPE(
+                    "WorkParallelForN chunk", r.begin(), r.end());
+                Work_ParallelismTaskScope regionScope(_region);
                 // Note that we std::forward _fn using Fn in order get the
                 // right operator().
                 // We maintain the right type in this way:
@@ -79,6 +81,7 @@ WorkParallelForN(size_t n, Fn &&callback, size_t grainSize)
 
         private:
             Fn &_fn;
+            Work_ParallelismRegionState *_region;
         };
 
         // In most cases we do not want to inherit cancellation state from the
@@ -86,16 +89,134 @@ WorkParallelForN(size_t n, Fn &&callback, size_t grainSize)
         tbb::task_group_context ctx(tbb::task_group_context::isolated);
         tbb::parallel_for(tbb::blocked_range<size_t>(0,n,grainSize),
             Work_ParallelForN_TBB(callback),
+            partitioner,
             ctx);
 
     } else {
 
-        // If concurrency is limited to 1, execute serially.
+        // If concurrency is limited to 1, execute serially, as a single
+        // chunk.
+        WORK_TRACE_RANGE_SCOPE("WorkParallelForN chunk", 0, n);
         WorkSerialForN(n, std::forward<Fn>(callback));
 
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize = 1)
+///
+/// Runs \p callback in parallel over the range 0 to n.
+///
+/// Callback must be of the form:
+///
+///     void LoopCallback(size_t begin, size_t end);
+///
+/// grainSize specifies a minimum amount of work to be done per-thread. There
+/// is overhead to launching a thread (or task) and a typical guideline is that
+/// you want to have at least 10,000 instructions to count for the overhead of
+/// launching a thread.
+///
+template <typename Fn>
+void
+WorkParallelForN(size_t n, Fn &&callback, size_t grainSize)
+{
+    Work_ParallelForN(n, std::forward<Fn>(callback), grainSize,
+                      tbb::auto_partitioner());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize,
+///                  WorkAffinityPartitioner &partitioner)
+///
+/// Runs \p callback in parallel over the range 0 to n, using \p partitioner to
+/// map subranges to the threads that ran them in previous loops using the same
+/// partitioner.  See WorkAffinityPartitioner.
+///
+template <typename Fn>
+void
+WorkParallelForN(size_t n, Fn &&callback, size_t grainSize,
+                 WorkAffinityPartitioner &partitioner)
+{
+    Work_ParallelForN(n, std::forward<Fn>(callback), grainSize,
+                      Work_GetTbbPartitioner(partitioner));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize,
+///                  WorkStaticPartitioner partitioner)
+///
+/// Runs \p callback in parallel over the range 0 to n, splitting the range
+/// evenly among the threads up front.  See WorkStaticPartitioner.
+///
+template <typename Fn>
+void
+WorkParallelForN(size_t n, Fn &&callback, size_t grainSize,
+                 WorkStaticPartitioner partitioner)
+{
+    Work_ParallelForN(n, std::forward<Fn>(callback), grainSize,
+                      Work_GetTbbPartitioner(partitioner));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize,
+///                  const WorkCancellationToken &token)
+///
+/// Runs \p callback in parallel over the range 0 to n, unless \p token is
+/// cancelled.  Once it is, no further subranges are started, and the loop
+/// returns when the running ones complete, so only part of the range may have
+/// been processed.  If concurrency is limited to 1, the range is processed
+/// serially in subranges of \p grainSize, checking \p token between them.
+/// See WorkCancellationToken.
+///
+template <typename Fn>
+void
+WorkParallelForN(size_t n, Fn &&callback, size_t grainSize,
+                 const WorkCancellationToken &token)
+{
+    if (n == 0 || token.IsCancelled())
+        return;
+
+    WORK_TRACE_SCOPE("WorkParallelForN");
+
+    // Don't bother with parallel_for, if concurrency is limited to 1.
+    if (WorkHasConcurrency()) {
+        Work_ParallelismRegionState *region = Work_GetParallelismRegion();
+        tbb::task_group_context ctx(tbb::task_group_context::isolated);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0,n,grainSize),
+            [&callback, &token, &ctx, region](
+                const tbb::blocked_range<size_t> &r) {
+                WORK_TRACE_RANGE_SCOPE(
+                    "WorkParallelForN chunk", r.begin(), r.end());
+                Work_ParallelismTaskScope regionScope(region);
+                // Cancelling the context stops the loop from splitting.
+                if (token.IsCancelled()) {
+                    ctx.cancel_group_execution();
+                    return;
+                }
+                callback(r.begin(), r.end());
+            },
+            tbb::auto_partitioner(),
+            ctx);
+
+    } else {
+
+        // If concurrency is limited to 1, execute serially, in chunks so
+        // that cancellation is still noticed.
+        const size_t chunkSize = std::max<size_t>(grainSize, 1);
+        for (size_t begin = 0; begin < n && !token.IsCancelled(); ) {
+            const size_t end = begin + std::min(chunkSize, n - begin);
+            WORK_TRACE_RANGE_SCOPE("WorkParallelForN chunk", begin, end);
+            callback(begin, end);
+            begin = end;
+        }
+
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// WorkParallelForN(size_t n, CallbackType callback, size_t grainSize = 1)
@@ -114,6 +235,83 @@ WorkParallelForN(size_t n, Fn &&callback)
     WorkParallelForN(n, std::forward<Fn>(callback), 1);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// WorkParallelForNAdaptive(size_t n, CallbackType callback)
+///
+/// Runs \p callback in parallel over the range 0 to n, choosing the grain size
+/// at runtime, and returns the grain size that was used.
+///
+/// Callback must be of the form:
+///
+///     void LoopCallback(size_t begin, size_t end);
+///
+/// The first iterations are run on the calling thread in chunks of doubling
+/// size, and timed, until a chunk takes long enough to measure reliably or a
+/// small fraction of the range has been sampled.  The measured per-iteration
+/// cost then determines a grain size that gives each task roughly 10
+/// microseconds of work, bounded so there remain several tasks per thread, and
+/// the rest of the range is run in parallel with it.
+///
+/// This suits call sites whose per-iteration cost is unknown or varies between
+/// calls.  When the cost is stable, the returned grain size can be recorded and
+/// passed to WorkParallelForN() directly to avoid the sampling.
+///
+template <typename Fn>
+size_t
+WorkParallelForNAdaptive(size_t n, Fn &&callback)
+{
+    if (n == 0)
+        return 1;
+
+    // If concurrency is limited to 1, execute serially.
+    if (!WorkHasConcurrency()) {
+        WorkSerialForN(n, std::forward<Fn>(callback));
+        return n;
+    }
+
+    // Amount of work each task should do, in nanoseconds.
+    constexpr int64_t targetNanoseconds = 10000;
+
+    // Leave the bulk of the range for the parallel loop: never sample more than
+    // an eighth of each thread's share.
+    const size_t concurrency = WorkGetConcurrencyLimit();
+    const size_t maxSampled = std::max<size_t>(1, n / (8 * concurrency));
+
+    size_t sampled = 0;
+    int64_t sampledNanoseconds = 0;
+    for (size_t chunk = 1; sampled < maxSampled; chunk *= 2) {
+        const size_t end = std::min(sampled + chunk, maxSampled);
+        const uint64_t startTicks = ArchGetTickTime();
+        callback(sampled, end);
+        const int64_t nanoseconds =
+            ArchTicksToNanoseconds(ArchGetTickTime() - startTicks);
+        sampled = end;
+        sampledNanoseconds += nanoseconds;
+        if (nanoseconds >= targetNanoseconds) {
+            break;
+        }
+    }
+
+    const size_t remaining = n - sampled;
+    const size_t maxGrainSize =
+        std::max<size_t>(1, remaining / (4 * concurrency));
+    const size_t grainSize = sampledNanoseconds > 0 ?
+        std::clamp<size_t>(
+            static_cast<size_t>(
+                static_cast<double>(sampled) * targetNanoseconds /
+                sampledNanoseconds),
+            1, maxGrainSize) :
+        maxGrainSize;
+
+    if (remaining) {
+        WorkParallelForN(remaining, [&callback, sampled](size_t b, size_t e) {
+            callback(sampled + b, sampled + e);
+        }, grainSize);
+    }
+    return grainSize;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// WorkParallelForEach(Iterator first, Iterator last, CallbackType callback)
@@ -132,6 +330,7 @@ inline void
 WorkParallelForEach(
     InputIterator first, InputIterator last, Fn &&fn)
 {
+    WORK_TRACE_SCOPE("WorkParallelForEach");
     tbb::task_group_context ctx(tbb::task_group_context::isolated);
     tbb::parallel_for_each(first, last, std::forward<Fn>(fn), ctx);
 }
@@ -0,0 +1,359 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./numaArena.h"
+#include "./threadLimits.h"
+
+#include <pxr/arch/defines.h>
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+#include <pxr/tf/errorTransport.h>
+
+// Blocked range is not used in this file, but this header happens to pull in
+// the TBB version header in a way that works in all TBB versions.
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_vector.h>
+#include <tbb/task_group.h>
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#if defined(ARCH_OS_LINUX)
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+namespace pxr {
+
+namespace {
+
+// A NUMA node and the CPUs of that node on which the process may run.
+struct _NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+#if defined(ARCH_OS_LINUX)
+
+// Parse a sysfs CPU list such as "0-15,32-47".
+std::vector<int>
+_ParseCpuList(const std::string &list)
+{
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string item = list.substr(pos, end - pos);
+        const size_t dash = item.find('-');
+        try {
+            const int first = std::stoi(item.substr(0, dash));
+            const int last = dash == std::string::npos ?
+                first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (const std::exception &) {
+            // Ignore malformed entries, including the trailing newline.
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+std::vector<_NumaNode>
+_DiscoverNumaNodes()
+{
+    std::vector<_NumaNode> nodes;
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return nodes;
+    }
+
+    const char *nodeDir = "/sys/devices/system/node";
+    DIR *dir = opendir(nodeDir);
+    if (!dir) {
+        return nodes;
+    }
+    while (dirent *entry = readdir(dir)) {
+        int id = 0;
+        if (sscanf(entry->d_name, "node%d", &id) != 1) {
+            continue;
+        }
+        std::ifstream file(std::string(nodeDir) + "/" + entry->d_name +
+                           "/cpulist");
+        std::string list;
+        if (!std::getline(file, list)) {
+            continue;
+        }
+
+        _NumaNode node { id, {} };
+        for (int cpu : _ParseCpuList(list)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        // Nodes without usable CPUs, like memory-only nodes or nodes
+        // excluded by the affinity mask, cannot run work.
+        if (!node.cpus.empty()) {
+            nodes.push_back(std::move(node));
+        }
+    }
+    closedir(dir);
+
+    std::sort(nodes.begin(), nodes.end(),
+              [](const _NumaNode &a, const _NumaNode &b) {
+                  return a.id < b.id;
+              });
+    return nodes;
+}
+
+#else
+
+std::vector<_NumaNode>
+_DiscoverNumaNodes()
+{
+    return {};
+}
+
+#endif
+
+const std::vector<_NumaNode> &
+_GetNumaNodes()
+{
+    static const std::vector<_NumaNode> nodes = []() {
+        std::vector<_NumaNode> nodes = _DiscoverNumaNodes();
+        if (nodes.empty()) {
+            // No NUMA information: report a single node with no affinity.
+            nodes.push_back(_NumaNode { 0, {} });
+        }
+        return nodes;
+    }();
+    return nodes;
+}
+
+#if defined(ARCH_OS_LINUX) && TBB_INTERFACE_VERSION_MAJOR >= 12
+
+// Observer that pins threads to a set of CPUs while they are in an arena, and
+// restores their previous affinity when they leave.
+class _AffinityObserver : public tbb::task_scheduler_observer
+{
+public:
+    _AffinityObserver(tbb::task_arena &arena, const std::vector<int> &cpus)
+        : tbb::task_scheduler_observer(arena)
+    {
+        CPU_ZERO(&_cpus);
+        for (int cpu : cpus) {
+            CPU_SET(cpu, &_cpus);
+        }
+        observe(true);
+    }
+
+    ~_AffinityObserver() override {
+        observe(false);
+    }
+
+    void on_scheduler_entry(bool) override {
+        // Arenas may be entered recursively, by executing in an arena from a
+        // task running in another one, so keep a stack of masks per thread.
+        cpu_set_t previous;
+        if (sched_getaffinity(0, sizeof(previous), &previous) != 0) {
+            previous = _cpus;
+        }
+        _GetSavedMasks().push_back(previous);
+        sched_setaffinity(0, sizeof(_cpus), &_cpus);
+    }
+
+    void on_scheduler_exit(bool) override {
+        std::vector<cpu_set_t> &saved = _GetSavedMasks();
+        if (!saved.empty()) {
+            sched_setaffinity(0, sizeof(cpu_set_t), &saved.back());
+            saved.pop_back();
+        }
+    }
+
+private:
+    static std::vector<cpu_set_t> &_GetSavedMasks() {
+        thread_local std::vector<cpu_set_t> saved;
+        return saved;
+    }
+
+    cpu_set_t _cpus;
+};
+
+#endif
+
+} // anon
+
+struct WorkNumaArena::_Impl {
+    int node;
+    unsigned concurrency;
+    tbb::task_arena arena;
+#if defined(ARCH_OS_LINUX) && TBB_INTERFACE_VERSION_MAJOR >= 12
+    std::unique_ptr<_AffinityObserver> observer;
+#endif
+};
+
+WorkNumaArena::WorkNumaArena(int node)
+    : _impl(new _Impl)
+{
+    const std::vector<_NumaNode> &nodes = _GetNumaNodes();
+    auto it = std::find_if(nodes.begin(), nodes.end(),
+                           [node](const _NumaNode &n) { return n.id == node; });
+    if (it == nodes.end()) {
+        TF_CODING_ERROR("Invalid NUMA node %d", node);
+        it = nodes.begin();
+    }
+
+    const unsigned limit = WorkGetConcurrencyLimit();
+    _impl->node = it->id;
+    _impl->concurrency = it->cpus.empty() ?
+        limit : std::min<unsigned>(it->cpus.size(), limit);
+
+    // Don't reserve a slot for external threads: tasks may be enqueued into
+    // the arena without any external thread ever joining it.
+    _impl->arena.initialize(_impl->concurrency, 0);
+
+#if defined(ARCH_OS_LINUX) && TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (!it->cpus.empty()) {
+        _impl->observer.reset(new _AffinityObserver(_impl->arena, it->cpus));
+    }
+#endif
+}
+
+WorkNumaArena::~WorkNumaArena() = default;
+
+int
+WorkNumaArena::GetNode() const
+{
+    return _impl->node;
+}
+
+unsigned
+WorkNumaArena::GetConcurrency() const
+{
+    return _impl->concurrency;
+}
+
+tbb::task_arena &
+WorkNumaArena::_GetTaskArena()
+{
+    return _impl->arena;
+}
+
+std::vector<int>
+WorkGetNumaNodes()
+{
+    std::vector<int> ids;
+    for (const _NumaNode &node : _GetNumaNodes()) {
+        ids.push_back(node.id);
+    }
+    return ids;
+}
+
+const std::vector<WorkNumaArena *> &
+WorkGetNumaArenas()
+{
+    // Deliberately leak these in case there are tasks still using them after
+    // we exit from main().
+    static const std::vector<WorkNumaArena *> *arenas = []() {
+        auto *arenas = new std::vector<WorkNumaArena *>;
+        for (const _NumaNode &node : _GetNumaNodes()) {
+            arenas->push_back(new WorkNumaArena(node.id));
+        }
+        return arenas;
+    }();
+    return *arenas;
+}
+
+void
+WorkReplicateAcrossNumaNodes(const std::function<void (WorkNumaArena &)> &fn)
+{
+    const std::vector<WorkNumaArena *> &arenas = WorkGetNumaArenas();
+
+    // Without worker threads, this thread would run every node's invocation
+    // in turn anyway, so do so directly.
+    if (arenas.size() == 1 || !WorkHasConcurrency()) {
+        for (WorkNumaArena *arena : arenas) {
+            arena->Execute([&fn, arena]() { fn(*arena); });
+        }
+        return;
+    }
+
+    tbb::concurrent_vector<TfErrorTransport> errors;
+    std::mutex mutex;
+    // The first exception thrown by any invocation, guarded by mutex.
+    std::exception_ptr exception;
+
+    // Run fn for arena, holding on to any exception and error it raises.
+    // Exceptions must not escape the tasks, which would cancel their group
+    // and lose the errors of the other nodes.
+    auto invoke = [&](WorkNumaArena &arena) {
+        TfErrorMark m;
+        std::exception_ptr taskException;
+        try {
+            fn(arena);
+        }
+        catch (...) {
+            taskException = std::current_exception();
+        }
+        if (!m.IsClean()) {
+            TfErrorTransport transport = m.Transport();
+            errors.grow_by(1)->swap(transport);
+        }
+        if (taskException) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception) {
+                exception = taskException;
+            }
+        }
+    };
+
+    // Hand all nodes but the first to a task group in their arena, and run
+    // the first one from this thread.  This thread then joins each arena to
+    // wait for its group, which runs the node's task itself if no worker has
+    // picked it up yet, so this cannot deadlock when called from a task with
+    // all other workers busy.
+    std::unique_ptr<tbb::task_group[]> groups(
+        new tbb::task_group[arenas.size()]);
+    for (size_t i = 1; i != arenas.size(); ++i) {
+        WorkNumaArena *arena = arenas[i];
+        tbb::task_group &group = groups[i];
+        arena->_GetTaskArena().execute([&invoke, &group, arena]() {
+            group.run([&invoke, arena]() { invoke(*arena); });
+        });
+    }
+
+    arenas[0]->Execute([&invoke, &arenas]() { invoke(*arenas[0]); });
+
+    for (size_t i = 1; i != arenas.size(); ++i) {
+        tbb::task_group &group = groups[i];
+        arenas[i]->_GetTaskArena().execute([&group]() { group.wait(); });
+    }
+
+    // Post all diagnostics to this thread's list.
+    for (TfErrorTransport &transport : errors) {
+        transport.Post();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+}  // namespace pxr
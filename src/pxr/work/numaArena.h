@@ -0,0 +1,124 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_NUMA_ARENA_H
+#define PXR_WORK_NUMA_ARENA_H
+
+/// \file work/numaArena.h
+
+#include "./api.h"
+#include "./arena.h"
+
+#include <tbb/task_arena.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pxr {
+
+class WorkNumaArena;
+
+WORK_API
+void WorkReplicateAcrossNumaNodes(
+    const std::function<void (WorkNumaArena &)> &fn);
+
+/// \class WorkNumaArena
+///
+/// A WorkNumaArena confines work to the CPUs of a single NUMA node.
+///
+/// On multi-socket machines, letting parallel work spread across sockets can
+/// leave it bandwidth-bound on remote memory accesses.  Work executed through
+/// Execute() only runs on threads pinned to the CPUs of the arena's node, so
+/// memory it first-touches is allocated on, and accessed from, that node.
+///
+/// For example,
+///
+/// \code
+/// for (WorkNumaArena *arena : WorkGetNumaArenas()) {
+///     arena->Execute([&]() {
+///         WorkParallelForN(n, ProcessPartition);
+///     });
+/// }
+/// \endcode
+///
+/// Any Work construct used within Execute(), such as WorkParallelForN() or a
+/// WorkDispatcher, runs its tasks on the arena's threads.  A WorkDispatcher
+/// used this way must also be waited on within Execute().
+///
+/// NUMA nodes are discovered from /sys/devices/system/node on Linux, and are
+/// restricted to the CPUs in the process's affinity mask.  Elsewhere, or if
+/// that information is unavailable, a single node 0 spanning all CPUs is
+/// reported, and arenas impose no CPU affinity.  The number of threads in an
+/// arena is also subject to the process-wide concurrency limit.
+///
+class WorkNumaArena
+{
+public:
+    /// Create an arena for NUMA node \p node, which must be one of the nodes
+    /// returned by WorkGetNumaNodes().  Prefer the shared instances returned
+    /// by WorkGetNumaArenas() to creating new arenas.
+    WORK_API explicit WorkNumaArena(int node);
+
+    WORK_API ~WorkNumaArena();
+
+    WorkNumaArena(WorkNumaArena const &) = delete;
+    WorkNumaArena &operator=(WorkNumaArena const &) = delete;
+
+    /// Return the NUMA node of this arena.
+    WORK_API int GetNode() const;
+
+    /// Return the maximum number of threads executing work in this arena.
+    WORK_API unsigned GetConcurrency() const;
+
+    /// Invoke \p fn in this arena and return its result.  The calling thread
+    /// joins the arena if it can, and is pinned to the node for the duration
+    /// of the call.  Otherwise \p fn is executed by one of the arena's threads
+    /// while the caller blocks.
+    template <class Fn>
+    auto Execute(Fn &&fn) {
+        tbb::task_arena &arena = _GetTaskArena();
+        return arena.execute([&arena, &fn]() -> decltype(auto) {
+            Work_ScopedCurrentArena scope(&arena);
+            return std::forward<Fn>(fn)();
+        });
+    }
+
+private:
+    friend void WorkReplicateAcrossNumaNodes(
+        const std::function<void (WorkNumaArena &)> &);
+
+    WORK_API tbb::task_arena &_GetTaskArena();
+
+    struct _Impl;
+    std::unique_ptr<_Impl> _impl;
+};
+
+/// Return the NUMA nodes on which this process may run, in increasing order.
+/// The result always contains at least one node.
+WORK_API std::vector<int> WorkGetNumaNodes();
+
+/// Return a WorkNumaArena for each node returned by WorkGetNumaNodes(), in
+/// the same order.  These arenas are created on first use and live until the
+/// end of the process.
+WORK_API const std::vector<WorkNumaArena *> &WorkGetNumaArenas();
+
+/// Invoke \p fn once for each NUMA node, concurrently, within that node's
+/// arena from WorkGetNumaArenas(), and wait for all invocations to complete.
+///
+/// This is useful to build per-node replicas of read-mostly data, so that
+/// later work on each node only reads local memory.  Errors posted by \p fn
+/// are transported to the calling thread.  If \p fn throws, the first
+/// exception is rethrown on the calling thread once the invocations that
+/// were started complete.
+///
+WORK_API
+void WorkReplicateAcrossNumaNodes(
+    const std::function<void (WorkNumaArena &)> &fn);
+
+}  // namespace pxr
+
+#endif // PXR_WORK_NUMA_ARENA_H
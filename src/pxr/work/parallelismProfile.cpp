@@ -0,0 +1,199 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./parallelismProfile.h"
+#include "./threadLimits.h"
+
+#include <pxr/arch/timing.h>
+#include <pxr/tf/envSetting.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+TF_DEFINE_ENV_SETTING(
+    PXR_WORK_PARALLELISM_PROFILE, false,
+    "Profile the parallelism of named scoped-parallelism regions. "
+    "See WorkParallelismRegionStats.");
+
+namespace pxr {
+
+std::atomic<bool> Work_ParallelismProfilingEnabled {
+    TfGetEnvSetting(PXR_WORK_PARALLELISM_PROFILE) };
+
+namespace {
+
+struct _Profile
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, WorkParallelismRegionStats> regions;
+};
+
+// The region invocation the current thread runs in.
+thread_local Work_ParallelismRegionState *_currentRegion = nullptr;
+
+} // anonymous namespace
+
+struct Work_ParallelismRegionState
+{
+    std::atomic<size_t> refCount { 1 };
+    // Time the tasks of the region ran on threads other than the one that
+    // invoked it, in ticks.
+    std::atomic<uint64_t> taskTicks { 0 };
+};
+
+Work_ParallelismRegionState *
+Work_GetCurrentParallelismRegion()
+{
+    return _currentRegion;
+}
+
+void
+Work_RetainParallelismRegion(Work_ParallelismRegionState *state)
+{
+    state->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+Work_ReleaseParallelismRegion(Work_ParallelismRegionState *state)
+{
+    if (state->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete state;
+    }
+}
+
+void
+Work_ParallelismTaskScope::_Begin(Work_ParallelismRegionState *region)
+{
+    // Tasks that the thread runs while running the region, or one of its
+    // tasks, are already accounted for.
+    if (_currentRegion == region) {
+        return;
+    }
+    _region = region;
+    _previous = _currentRegion;
+    _currentRegion = region;
+    _startTicks = ArchGetTickTime();
+}
+
+void
+Work_ParallelismTaskScope::_End()
+{
+    _region->taskTicks.fetch_add(
+        ArchGetTickTime() - _startTicks, std::memory_order_relaxed);
+    _currentRegion = _previous;
+}
+
+static _Profile &
+_GetProfile()
+{
+    static _Profile *profile = new _Profile;
+    return *profile;
+}
+
+bool
+WorkIsParallelismProfilingEnabled()
+{
+    return Work_ParallelismProfilingEnabled.load(std::memory_order_relaxed);
+}
+
+void
+WorkSetParallelismProfilingEnabled(bool enabled)
+{
+    Work_ParallelismProfilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::map<std::string, WorkParallelismRegionStats>
+WorkGetParallelismProfile()
+{
+    _Profile &profile = _GetProfile();
+    std::lock_guard<std::mutex> lock(profile.mutex);
+    return std::map<std::string, WorkParallelismRegionStats>(
+        profile.regions.begin(), profile.regions.end());
+}
+
+void
+WorkResetParallelismProfile()
+{
+    _Profile &profile = _GetProfile();
+    std::lock_guard<std::mutex> lock(profile.mutex);
+    profile.regions.clear();
+}
+
+void
+WorkReportParallelismProfile(std::ostream &out)
+{
+    using _Entry = std::pair<std::string, WorkParallelismRegionStats>;
+    const std::map<std::string, WorkParallelismRegionStats> regions =
+        WorkGetParallelismProfile();
+    std::vector<_Entry> entries(regions.begin(), regions.end());
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const _Entry &lhs, const _Entry &rhs) {
+            return lhs.second.GetEfficiency() < rhs.second.GetEfficiency();
+        });
+
+    out << "Scoped parallelism profile:\n";
+    char line[128];
+    std::snprintf(line, sizeof(line), "%12s %12s %12s %12s  %s\n",
+        "efficiency", "invocations", "wall (ms)", "idle (ms)", "region");
+    out << line;
+    for (const _Entry &entry : entries) {
+        const WorkParallelismRegionStats &stats = entry.second;
+        const uint64_t idleNanoseconds =
+            stats.availableNanoseconds -
+            std::min(stats.activeNanoseconds, stats.availableNanoseconds);
+        std::snprintf(line, sizeof(line), "%12.3f %12zu %12.3f %12.3f  ",
+            stats.GetEfficiency(), stats.numInvocations,
+            stats.wallNanoseconds / 1e6, idleNanoseconds / 1e6);
+        out << line << entry.first << '\n';
+    }
+}
+
+void
+Work_ParallelismRegion::_Begin(const char *name)
+{
+    _state = new Work_ParallelismRegionState;
+    _previous = _currentRegion;
+    _currentRegion = _state;
+    _name = name;
+    _concurrency = WorkGetConcurrencyLimit();
+    _startTicks = ArchGetTickTime();
+}
+
+void
+Work_ParallelismRegion::_End()
+{
+    const uint64_t ticks = ArchGetTickTime() - _startTicks;
+    const uint64_t taskTicks =
+        _state->taskTicks.load(std::memory_order_relaxed);
+    _currentRegion = _previous;
+    if (_previous) {
+        _previous->taskTicks.fetch_add(taskTicks, std::memory_order_relaxed);
+    }
+    Work_ReleaseParallelismRegion(_state);
+
+    // The calling thread is busy for the duration of the region, running or
+    // waiting on its tasks.
+    const uint64_t activeTicks = ticks + taskTicks;
+
+    const uint64_t wallNanoseconds =
+        std::max<int64_t>(0, ArchTicksToNanoseconds(ticks));
+    const uint64_t activeNanoseconds =
+        std::max<int64_t>(0, ArchTicksToNanoseconds(activeTicks));
+
+    _Profile &profile = _GetProfile();
+    std::lock_guard<std::mutex> lock(profile.mutex);
+    WorkParallelismRegionStats &stats = profile.regions[_name];
+    ++stats.numInvocations;
+    stats.wallNanoseconds += wallNanoseconds;
+    stats.availableNanoseconds += wallNanoseconds * _concurrency;
+    stats.activeNanoseconds += activeNanoseconds;
+}
+
+}  // namespace pxr
@@ -0,0 +1,218 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_PARALLELISM_PROFILE_H
+#define PXR_WORK_PARALLELISM_PROFILE_H
+
+/// \file work/parallelismProfile.h
+
+#include "./api.h"
+
+#include <pxr/arch/hints.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace pxr {
+
+/// \struct WorkParallelismRegionStats
+///
+/// Statistics about the invocations of a named scoped-parallelism region, see
+/// WorkWithNamedScopedParallelism(), collected while
+/// WorkIsParallelismProfilingEnabled() is true.
+///
+/// The parallelism of a region is measured by the time threads spend running
+/// its work.  The thread that invokes the region is counted for its entire
+/// duration, since it runs the region's code, or runs the region's tasks
+/// while it waits on them.  Other threads are counted while they run tasks
+/// started within the region: dispatcher tasks, the chunks of
+/// WorkParallelForN(), of reductions and of scans, and the subranges of
+/// stable and radix sorts.  Time is attributed to the innermost
+/// region, and added to the enclosing ones when it ends.  Threads that are
+/// idle, or that run the tasks of other regions, are not counted, so regions
+/// running concurrently are measured independently.
+///
+/// The time of a task is recorded when it completes, so tasks that are still
+/// running when the region ends, such as tasks of a dispatcher that is waited
+/// on outside of the region, are not accounted for.
+///
+struct WorkParallelismRegionStats
+{
+    /// Number of times the region was invoked.
+    size_t numInvocations = 0;
+
+    /// Total time spent in the region, in nanoseconds.
+    uint64_t wallNanoseconds = 0;
+
+    /// Total time spent in the region multiplied by the concurrency limit at
+    /// the time, in nanoseconds.  This is the thread time that was available
+    /// to the region.
+    uint64_t availableNanoseconds = 0;
+
+    /// Total time threads spent running the work of the region, in
+    /// nanoseconds.
+    uint64_t activeNanoseconds = 0;
+
+    /// Return the ratio of the active to the available thread time.  Values
+    /// well below 1 indicate threads left idle, for example while the calling
+    /// thread waits on isolated work that does not expose enough parallelism.
+    /// Values above 1 indicate oversubscription.
+    double GetEfficiency() const {
+        return availableNanoseconds ?
+            static_cast<double>(activeNanoseconds) / availableNanoseconds : 0.0;
+    }
+};
+
+/// Return true if scoped-parallelism regions are being profiled.  This
+/// defaults to the value of the PXR_WORK_PARALLELISM_PROFILE environment
+/// variable.
+WORK_API bool WorkIsParallelismProfilingEnabled();
+
+/// Enable or disable the profiling of scoped-parallelism regions.
+WORK_API void WorkSetParallelismProfilingEnabled(bool enabled);
+
+/// Return the statistics of each named region that was invoked while
+/// profiling was enabled, since the last call to WorkResetParallelismProfile().
+WORK_API std::map<std::string, WorkParallelismRegionStats>
+WorkGetParallelismProfile();
+
+/// Reset the statistics returned by WorkGetParallelismProfile().
+WORK_API void WorkResetParallelismProfile();
+
+/// Write a report of the statistics returned by WorkGetParallelismProfile()
+/// to \p out, with one line per region, sorted by increasing efficiency.
+WORK_API void WorkReportParallelismProfile(std::ostream &out);
+
+// Whether regions are profiled, read on every region invocation.
+extern WORK_API std::atomic<bool> Work_ParallelismProfilingEnabled;
+
+// The state of a profiled region invocation, to which the tasks started
+// within it add the time they run.  It is reference counted, since
+// dispatcher tasks may outlive the region.
+struct Work_ParallelismRegionState;
+
+// Return the region invocation the calling thread runs in, or nullptr.
+WORK_API Work_ParallelismRegionState *Work_GetCurrentParallelismRegion();
+
+WORK_API void Work_RetainParallelismRegion(Work_ParallelismRegionState *);
+WORK_API void Work_ReleaseParallelismRegion(Work_ParallelismRegionState *);
+
+// Return the region invocation the calling thread runs in, if profiling is
+// enabled, for tasks started by the calling thread to be attributed to it.
+inline Work_ParallelismRegionState *
+Work_GetParallelismRegion()
+{
+    if (ARCH_LIKELY(!Work_ParallelismProfilingEnabled.load(
+            std::memory_order_relaxed))) {
+        return nullptr;
+    }
+    return Work_GetCurrentParallelismRegion();
+}
+
+// A reference to a region invocation, held by tasks that may outlive it.
+class Work_ParallelismRegionRef
+{
+public:
+    explicit Work_ParallelismRegionRef(Work_ParallelismRegionState *state)
+        : _state(state) {
+        if (ARCH_UNLIKELY(_state)) {
+            Work_RetainParallelismRegion(_state);
+        }
+    }
+
+    Work_ParallelismRegionRef(Work_ParallelismRegionRef &&other)
+        : _state(other._state) {
+        other._state = nullptr;
+    }
+
+    ~Work_ParallelismRegionRef() {
+        if (ARCH_UNLIKELY(_state)) {
+            Work_ReleaseParallelismRegion(_state);
+        }
+    }
+
+    Work_ParallelismRegionRef(Work_ParallelismRegionRef const &) = delete;
+    Work_ParallelismRegionRef &operator=(
+        Work_ParallelismRegionRef const &) = delete;
+
+    Work_ParallelismRegionState *Get() const {
+        return _state;
+    }
+
+private:
+    Work_ParallelismRegionState *_state;
+};
+
+// Attribute the time until this object is destroyed to region, unless it is
+// null or the calling thread already runs in it.  Tasks started within a
+// region create one of these around the work they do.
+class Work_ParallelismTaskScope
+{
+public:
+    explicit Work_ParallelismTaskScope(Work_ParallelismRegionState *region)
+        : _region(nullptr) {
+        if (ARCH_UNLIKELY(region)) {
+            _Begin(region);
+        }
+    }
+
+    ~Work_ParallelismTaskScope() {
+        if (ARCH_UNLIKELY(_region)) {
+            _End();
+        }
+    }
+
+    Work_ParallelismTaskScope(Work_ParallelismTaskScope const &) = delete;
+    Work_ParallelismTaskScope &operator=(
+        Work_ParallelismTaskScope const &) = delete;
+
+private:
+    WORK_API void _Begin(Work_ParallelismRegionState *region);
+    WORK_API void _End();
+
+    Work_ParallelismRegionState *_region;
+    Work_ParallelismRegionState *_previous;
+    uint64_t _startTicks;
+};
+
+// Profile the invocation of the region name for the lifetime of this object,
+// if profiling is enabled.
+class Work_ParallelismRegion
+{
+public:
+    explicit Work_ParallelismRegion(const char *name) : _state(nullptr) {
+        if (ARCH_UNLIKELY(Work_ParallelismProfilingEnabled.load(
+                std::memory_order_relaxed))) {
+            _Begin(name);
+        }
+    }
+
+    ~Work_ParallelismRegion() {
+        if (ARCH_UNLIKELY(_state)) {
+            _End();
+        }
+    }
+
+    Work_ParallelismRegion(Work_ParallelismRegion const &) = delete;
+    Work_ParallelismRegion &operator=(Work_ParallelismRegion const &) = delete;
+
+private:
+    WORK_API void _Begin(const char *name);
+    WORK_API void _End();
+
+    Work_ParallelismRegionState *_state;
+    Work_ParallelismRegionState *_previous;
+    const char *_name;
+    uint64_t _startTicks;
+    size_t _concurrency;
+};
+
+}  // namespace pxr
+
+#endif // PXR_WORK_PARALLELISM_PROFILE_H
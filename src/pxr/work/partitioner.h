@@ -0,0 +1,78 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_PARTITIONER_H
+#define PXR_WORK_PARTITIONER_H
+
+/// \file work/partitioner.h
+
+#include "./api.h"
+
+#include <tbb/partitioner.h>
+
+namespace pxr {
+
+/// \class WorkAffinityPartitioner
+///
+/// A partitioner that remembers which thread executed each subrange of a
+/// parallel loop, and replays that mapping the next time it is used.
+///
+/// Passing the same WorkAffinityPartitioner to repeated WorkParallelForN() or
+/// WorkParallelReduceN() calls over the same range and grain size tends to run
+/// each subrange on the thread that ran it previously, which preserves cache
+/// locality when the loops touch the same data, as in iterative solvers.
+///
+/// The partitioner must outlive the loops using it, and must not be used by
+/// concurrent loops.
+///
+/// \code
+/// WorkAffinityPartitioner partitioner;
+/// for (int pass = 0; pass != numPasses; ++pass) {
+///     WorkParallelForN(points.size(), RelaxPoints, 1024, partitioner);
+/// }
+/// \endcode
+///
+class WorkAffinityPartitioner
+{
+public:
+    WorkAffinityPartitioner() = default;
+
+    WorkAffinityPartitioner(WorkAffinityPartitioner const &) = delete;
+    WorkAffinityPartitioner &operator=(WorkAffinityPartitioner const &) = delete;
+
+private:
+    friend tbb::affinity_partitioner &
+    Work_GetTbbPartitioner(WorkAffinityPartitioner &);
+
+    tbb::affinity_partitioner _partitioner;
+};
+
+/// \class WorkStaticPartitioner
+///
+/// Tag requesting that a parallel loop split its range evenly among the
+/// available threads up front, without further load balancing.
+///
+/// Each thread is given a contiguous chunk of the range, and the assignment of
+/// chunks to threads is the same from call to call.  This has the lowest
+/// scheduling overhead and a deterministic mapping, but performs poorly when
+/// iterations have uneven costs or when other work competes for the threads.
+///
+struct WorkStaticPartitioner {};
+
+inline tbb::affinity_partitioner &
+Work_GetTbbPartitioner(WorkAffinityPartitioner &partitioner)
+{
+    return partitioner._partitioner;
+}
+
+inline tbb::static_partitioner
+Work_GetTbbPartitioner(WorkStaticPartitioner)
+{
+    return tbb::static_partitioner();
+}
+
+}  // namespace pxr
+
+#endif // PXR_WORK_PARTITIONER_H
@@ -0,0 +1,273 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_PIPELINE_H
+#define PXR_WORK_PIPELINE_H
+
+/// \file work/pipeline.h
+
+#include "./api.h"
+#include "./threadLimits.h"
+
+#include <pxr/tf/errorMark.h>
+#include <pxr/tf/errorTransport.h>
+
+#include <tbb/concurrent_vector.h>
+#include <tbb/task_group.h>
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+#include <tbb/parallel_pipeline.h>
+#else
+#include <tbb/pipeline.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace pxr {
+
+/// \enum WorkPipelineMode
+///
+/// How the items flowing through a stage of a WorkPipeline are processed.
+///
+enum class WorkPipelineMode
+{
+    /// Items are processed concurrently, in any order.
+    Parallel,
+
+    /// Items are processed one at a time, in the order the first stage
+    /// produced them.
+    SerialInOrder,
+
+    /// Items are processed one at a time, in any order.
+    SerialOutOfOrder
+};
+
+// Errors posted by the stages of a pipeline.
+using Work_PipelineErrors = tbb::concurrent_vector<TfErrorTransport>;
+
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+template <class In, class Out>
+using Work_PipelineFilter = tbb::filter<In, Out>;
+#else
+template <class In, class Out>
+using Work_PipelineFilter = tbb::filter_t<In, Out>;
+#endif
+
+// Return the TBB filter mode corresponding to mode.
+inline auto
+Work_GetTbbFilterMode(WorkPipelineMode mode)
+{
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    using _Mode = tbb::filter_mode;
+#else
+    using _Mode = tbb::filter::mode;
+#endif
+    switch (mode) {
+    case WorkPipelineMode::SerialInOrder:
+        return _Mode::serial_in_order;
+    case WorkPipelineMode::SerialOutOfOrder:
+        return _Mode::serial_out_of_order;
+    default:
+        return _Mode::parallel;
+    }
+}
+
+// Move the errors posted since mark was created to errors.
+inline void
+Work_TransportPipelineErrors(
+    const TfErrorMark &mark, Work_PipelineErrors *errors)
+{
+    TfErrorTransport transport = mark.Transport();
+    errors->grow_by(1)->swap(transport);
+}
+
+/// \class WorkPipeline
+///
+/// A chain of stages through which items flow, taking items of type \p In and
+/// producing items of type \p Out, run by WorkRunPipeline().
+///
+/// Pipelines process streams of items in successive stages, for example
+/// reading, decompressing, parsing and composing files, such that all stages
+/// run concurrently on different items.  Unlike running each stage to
+/// completion in a WorkDispatcher before starting the next one, this keeps
+/// all threads busy while only a bounded number of items are in flight, see
+/// WorkRunPipeline().
+///
+/// A pipeline with a single stage is created from a function and a
+/// WorkPipelineMode, and stages are chained with operator&.  A pipeline that
+/// can be run takes no input and produces no output: its first stage produces
+/// items and its last stage consumes them.  Depending on the types, the
+/// function of a stage must be of the form:
+///
+///     std::optional<Out> Source();  // In is void, returns nullopt at the end
+///     Out Filter(In item);
+///     void Sink(In item);
+///
+/// The items produced by the first stage must be default constructible.
+///
+/// \code
+/// std::vector<std::string> paths = ...;
+/// size_t next = 0;
+/// WorkRunPipeline(16,
+///     WorkPipeline<void, std::string>(WorkPipelineMode::SerialInOrder,
+///         [&]() -> std::optional<std::string> {
+///             if (next == paths.size()) {
+///                 return std::nullopt;
+///             }
+///             return paths[next++];
+///         }) &
+///     WorkPipeline<std::string, Data>(WorkPipelineMode::Parallel,
+///         [](std::string path) { return Load(path); }) &
+///     WorkPipeline<Data, void>(WorkPipelineMode::SerialInOrder,
+///         [&](Data data) { Compose(std::move(data)); }));
+/// \endcode
+///
+/// Any errors that are posted by the stages are transported and re-posted
+/// on the thread that runs the pipeline, as WorkDispatcher::Wait() does.
+///
+template <class In, class Out>
+class WorkPipeline
+{
+public:
+    /// Create a pipeline with a single stage that invokes \p fn in \p mode.
+    template <class Fn>
+    WorkPipeline(WorkPipelineMode mode, Fn &&fn)
+        : _makeFilter(_MakeStage(
+            mode, std::make_shared<std::decay_t<Fn>>(std::forward<Fn>(fn))))
+    {
+    }
+
+private:
+    template <class I, class O> friend class WorkPipeline;
+
+    template <class I, class M, class O>
+    friend WorkPipeline<I, O>
+    operator&(const WorkPipeline<I, M> &, const WorkPipeline<M, O> &);
+
+    template <class I, class O>
+    friend void WorkRunPipeline(size_t, const WorkPipeline<I, O> &);
+
+    using _Filter = Work_PipelineFilter<In, Out>;
+    using _MakeFilter = std::function<_Filter (Work_PipelineErrors *)>;
+
+    explicit WorkPipeline(_MakeFilter &&makeFilter)
+        : _makeFilter(std::move(makeFilter))
+    {
+    }
+
+    // Return a function creating the TBB filter for a stage invoking fn,
+    // and transporting its errors to the given list.
+    template <class Fn>
+    static _MakeFilter
+    _MakeStage(WorkPipelineMode mode, std::shared_ptr<Fn> fn) {
+        return [mode, fn](Work_PipelineErrors *errors) {
+            return _Filter(Work_GetTbbFilterMode(mode),
+                           _Body<Fn>{fn.get(), errors});
+        };
+    }
+
+    // The body of a TBB filter.
+    template <class Fn, class I = In, class = void>
+    struct _Body {
+        Fn *fn;
+        Work_PipelineErrors *errors;
+
+        Out operator()(I item) const {
+            TfErrorMark m;
+            if constexpr (std::is_void_v<Out>) {
+                (*fn)(std::move(item));
+                if (!m.IsClean()) {
+                    Work_TransportPipelineErrors(m, errors);
+                }
+            }
+            else {
+                Out result = (*fn)(std::move(item));
+                if (!m.IsClean()) {
+                    Work_TransportPipelineErrors(m, errors);
+                }
+                return result;
+            }
+        }
+    };
+
+    // The body of the first stage of a pipeline.
+    template <class Fn, class I>
+    struct _Body<Fn, I, std::enable_if_t<std::is_void_v<I>>> {
+        Fn *fn;
+        Work_PipelineErrors *errors;
+
+        Out operator()(tbb::flow_control &control) const {
+            TfErrorMark m;
+            std::optional<Out> result = (*fn)();
+            if (!m.IsClean()) {
+                Work_TransportPipelineErrors(m, errors);
+            }
+            if (!result) {
+                control.stop();
+                return Out();
+            }
+            return std::move(*result);
+        }
+    };
+
+    _MakeFilter _makeFilter;
+};
+
+/// Return a pipeline running the stages of \p first, then those of \p second.
+template <class In, class Mid, class Out>
+WorkPipeline<In, Out>
+operator&(const WorkPipeline<In, Mid> &first,
+          const WorkPipeline<Mid, Out> &second)
+{
+    return WorkPipeline<In, Out>(
+        [first = first._makeFilter, second = second._makeFilter](
+            Work_PipelineErrors *errors) {
+            return first(errors) & second(errors);
+        });
+}
+
+/// Run \p pipeline until its first stage has no more items, with at most
+/// \p maxTokens items in flight at any time.
+///
+/// The number of tokens bounds both the parallelism of the pipeline and the
+/// memory used by items that are being processed.  A value a few times the
+/// concurrency limit is usually enough to keep threads busy despite stages
+/// of uneven cost.  If concurrency is limited to 1, each item flows through
+/// all stages before the next one is produced.
+///
+/// As WorkParallelForN() does, the pipeline runs in an isolated task group
+/// context, so that it is not cancelled along with the enclosing tasks.
+/// Errors posted by the stages are posted on the calling thread once the
+/// pipeline completes.
+///
+template <class In, class Out>
+void
+WorkRunPipeline(size_t maxTokens, const WorkPipeline<In, Out> &pipeline)
+{
+    static_assert(std::is_void_v<In> && std::is_void_v<Out>,
+                  "Only pipelines that neither take nor produce items "
+                  "can be run");
+
+    // Don't bother having several items in flight, if concurrency is limited
+    // to 1.
+    const size_t numTokens =
+        WorkHasConcurrency() ? std::max<size_t>(maxTokens, 1) : 1;
+
+    Work_PipelineErrors errors;
+    tbb::task_group_context ctx(tbb::task_group_context::isolated);
+    tbb::parallel_pipeline(numTokens, pipeline._makeFilter(&errors), ctx);
+
+    for (TfErrorTransport &transport : errors) {
+        transport.Post();
+    }
+}
+
+}  // namespace pxr
+
+#endif // PXR_WORK_PIPELINE_H
@@ -0,0 +1,346 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_PIPELINE_QUEUE_H
+#define PXR_WORK_PIPELINE_QUEUE_H
+
+/// \file work/pipelineQueue.h
+
+#include "./dispatcher.h"
+#include "./threadLimits.h"
+
+#include <pxr/arch/align.h>
+#include <pxr/arch/hints.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pxr {
+
+/// \class WorkPipelineQueue
+///
+/// A bounded, lock-free, multiple-producer multiple-consumer queue whose
+/// elements are consumed by tasks run in a WorkDispatcher.
+///
+/// Producers, typically tasks in the same dispatcher, add elements with
+/// Push().  Consumer tasks are started on demand, much like WorkSingularTask
+/// is woken, up to a maximum number of concurrent consumers: a consumer is
+/// started when none is running, or when the queue holds more elements than
+/// the running consumers take in one batch.  Each consumer repeatedly removes
+/// up to a batch of elements and passes them to the consumer function, then
+/// stops once the queue is empty.
+///
+/// The queue has a fixed capacity, which bounds the memory used when
+/// producers outpace consumers.  When the queue is full, Push() applies
+/// back-pressure by having the producer consume a batch itself before
+/// retrying, so producers never block waiting for consumer tasks to be
+/// scheduled.
+///
+/// The consumer function must be of the form:
+///
+///     void Consumer(std::vector<T> &batch);
+///
+/// It may be invoked concurrently, by consumer tasks and producers, and may
+/// move the elements out of the batch.  Elements are removed in the order
+/// they were added, but batches may be consumed in any order.
+///
+/// Callers must wait on the dispatcher before destroying the queue.
+/// Elements that remain in the queue, for example because the dispatcher was
+/// cancelled, are destroyed along with it.  Once the dispatcher has been
+/// waited on, the queue may be used again, and the next call to Push() starts
+/// a consumer for the remaining elements as well.
+///
+/// The queue is implemented as an array of cells tagged with sequence
+/// numbers, after Dmitry Vyukov's bounded MPMC queue: producers and consumers
+/// each claim a cell with a single compare-and-swap, and never wait on each
+/// other unless the queue is full or empty.
+///
+template <class T>
+class WorkPipelineQueue
+{
+public:
+    using ValueType = T;
+
+    WorkPipelineQueue(WorkPipelineQueue const &) = delete;
+    WorkPipelineQueue &operator=(WorkPipelineQueue const &) = delete;
+
+    /// Create a queue holding up to \p capacity elements, rounded up to a
+    /// power of two, whose elements are passed to \p consumer by tasks run in
+    /// \p dispatcher.  Callers must ensure that \p dispatcher lives at least
+    /// as long as this queue.
+    ///
+    /// At most \p maxConsumers consumer tasks run at once, zero meaning the
+    /// concurrency limit, and each batch holds at most \p maxBatchSize
+    /// elements.
+    template <class Callable>
+    WorkPipelineQueue(WorkDispatcher &dispatcher,
+                      size_t capacity,
+                      Callable &&consumer,
+                      size_t maxConsumers = 0,
+                      size_t maxBatchSize = 64)
+        : _dispatcher(dispatcher)
+        , _consumer(std::forward<Callable>(consumer))
+        , _maxConsumers(
+            maxConsumers ? maxConsumers : WorkGetConcurrencyLimit())
+        , _maxBatchSize(std::max<size_t>(maxBatchSize, 1))
+        , _numConsumers(0)
+        , _enqueuePos(0)
+        , _dequeuePos(0)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        _mask = size - 1;
+        _cells.reset(new _Cell[size]);
+        for (size_t i = 0; i != size; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~WorkPipelineQueue() {
+        T *value;
+        while (_TryClaim(&value)) {
+            value->~T();
+        }
+    }
+
+    /// Return the maximum number of elements the queue can hold.
+    size_t GetCapacity() const {
+        return _mask + 1;
+    }
+
+    /// Return the number of elements in the queue.  This is only a snapshot
+    /// if producers or consumers are running concurrently.
+    size_t GetSize() const {
+        const size_t dequeuePos = _dequeuePos.load();
+        const size_t enqueuePos = _enqueuePos.load();
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    /// Add \p value to the queue and make sure a consumer will take it.  If
+    /// the queue is full, consume a batch of elements on the calling thread,
+    /// and retry.
+    template <class U>
+    void Push(U &&value) {
+        while (!_TryEnqueue(std::forward<U>(value))) {
+            // If there is nothing to consume, the elements are being added or
+            // removed by other threads, so let them finish.
+            if (!_ConsumeBatch()) {
+                std::this_thread::yield();
+            }
+        }
+        _WakeConsumer();
+    }
+
+    /// Add \p value to the queue and make sure a consumer will take it,
+    /// unless the queue is full.  Return true if \p value was added.
+    template <class U>
+    bool TryPush(U &&value) {
+        if (!_TryEnqueue(std::forward<U>(value))) {
+            return false;
+        }
+        _WakeConsumer();
+        return true;
+    }
+
+private:
+    struct _Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Store value in the next free cell, and return false if there is none.
+    template <class U>
+    bool _TryEnqueue(U &&value) {
+        _Cell *cell;
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff =
+                static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // The cell still holds the element from the previous lap.
+                return false;
+            }
+            else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Claim the next full cell, setting *value to its element, and return
+    // false if there is none.  The caller must release the cell with
+    // _Release() once it is done with the element.
+    bool _TryClaim(T **value, size_t *claimedPos = nullptr) {
+        _Cell *cell;
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff =
+                static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // The cell has not been filled yet.
+                return false;
+            }
+            else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        *value = std::launder(reinterpret_cast<T *>(cell->storage));
+        if (claimedPos) {
+            *claimedPos = pos;
+        }
+        return true;
+    }
+
+    // Make the cell claimed at pos available to producers for the next lap.
+    void _Release(size_t pos) {
+        _cells[pos & _mask].sequence.store(
+            pos + _mask + 1, std::memory_order_release);
+    }
+
+    // Move up to a batch of elements into batch, and return false if there
+    // were none.
+    bool _DequeueBatch(std::vector<T> *batch) {
+        T *value;
+        size_t pos;
+        while (batch->size() < _maxBatchSize && _TryClaim(&value, &pos)) {
+            batch->push_back(std::move(*value));
+            value->~T();
+            _Release(pos);
+        }
+        return !batch->empty();
+    }
+
+    // Consume a batch of elements on the calling thread, and return false if
+    // there were none.
+    bool _ConsumeBatch() {
+        std::vector<T> batch;
+        batch.reserve(_maxBatchSize);
+        if (!_DequeueBatch(&batch)) {
+            return false;
+        }
+        _consumer(batch);
+        return true;
+    }
+
+    // Task that runs a consumer, counted in _numConsumers from its creation
+    // until it stops consuming, or until it is destroyed if it did not run
+    // to completion, because the dispatcher was cancelled or the consumer
+    // function threw.
+    class _ConsumerTask {
+    public:
+        explicit _ConsumerTask(WorkPipelineQueue *queue)
+            : _queue(queue), _counted(true) {}
+
+        _ConsumerTask(_ConsumerTask &&other)
+            : _queue(other._queue), _counted(other._counted) {
+            other._counted = false;
+        }
+
+        ~_ConsumerTask() {
+            if (_counted) {
+                _queue->_numConsumers.fetch_sub(1);
+            }
+        }
+
+        _ConsumerTask(_ConsumerTask const &) = delete;
+        _ConsumerTask &operator=(_ConsumerTask const &) = delete;
+
+        void operator()() const {
+            _queue->_Consume(&_counted);
+        }
+
+    private:
+        WorkPipelineQueue *_queue;
+        mutable bool _counted;
+    };
+
+    // Start a consumer task if none is running, or if there are more
+    // elements than the running ones take in one batch.
+    void _WakeConsumer() {
+        size_t numConsumers = _numConsumers.load();
+        while (numConsumers < _maxConsumers &&
+               (numConsumers == 0 ||
+                GetSize() > numConsumers * _maxBatchSize)) {
+            if (_numConsumers.compare_exchange_weak(
+                    numConsumers, numConsumers + 1)) {
+                _dispatcher.Run(_ConsumerTask(this));
+                return;
+            }
+        }
+    }
+
+    // Consume batches until the queue is empty.  *counted tells whether the
+    // consumer is counted in _numConsumers, and is cleared when it stops.
+    void _Consume(bool *counted) {
+        std::vector<T> batch;
+        batch.reserve(_maxBatchSize);
+        for (;;) {
+            while (_DequeueBatch(&batch)) {
+                _consumer(batch);
+                batch.clear();
+            }
+
+            // A producer may have added an element after the last batch was
+            // taken, and not started a consumer since this one was running.
+            // Either it sees this consumer stop and starts another one, or
+            // this consumer sees the element and resumes.
+            size_t numConsumers = _numConsumers.fetch_sub(1) - 1;
+            *counted = false;
+            if (ARCH_LIKELY(GetSize() == 0)) {
+                return;
+            }
+            do {
+                if (numConsumers >= _maxConsumers) {
+                    return;
+                }
+            } while (!_numConsumers.compare_exchange_weak(
+                numConsumers, numConsumers + 1));
+            *counted = true;
+        }
+    }
+
+    WorkDispatcher &_dispatcher;
+    std::function<void (std::vector<T> &)> _consumer;
+    const size_t _maxConsumers;
+    const size_t _maxBatchSize;
+    size_t _mask;
+    std::unique_ptr<_Cell[]> _cells;
+    std::atomic<size_t> _numConsumers;
+
+    // Keep the producer and consumer positions on separate cache lines, since
+    // they are updated by different threads.
+    alignas(ARCH_CACHE_LINE_SIZE) std::atomic<size_t> _enqueuePos;
+    alignas(ARCH_CACHE_LINE_SIZE) std::atomic<size_t> _dequeuePos;
+};
+
+}  // namespace pxr
+
+#endif // PXR_WORK_PIPELINE_QUEUE_H
@@ -11,14 +11,79 @@
 /// \file work/reduce.h
 #include "./threadLimits.h"
 #include "./api.h"
+#include "./cancellation.h"
+#include "./parallelismProfile.h"
+#include "./partitioner.h"
+#include "./tracing.h"
 
 #include <tbb/blocked_range.h>
+#include <tbb/parallel_invoke.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/task_group.h>
 
+#include <algorithm>
+
 namespace pxr {
 
 
+// Runs WorkParallelReduceN() using the given TBB partitioner.
+template <typename Fn, typename Rn, typename V, typename Partitioner>
+V
+Work_ParallelReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback,
+    size_t grainSize,
+    Partitioner &&partitioner)
+{
+    if (n == 0)
+        return identity;
+
+    WORK_TRACE_SCOPE("WorkParallelReduceN");
+
+    // Don't bother with parallel_reduce, if concurrency is limited to 1.
+    if (WorkHasConcurrency()) {
+
+        class Work_Body_TBB
+        {
+        public:
+            Work_Body_TBB(Fn &fn)
+                : _fn(fn), _region(Work_GetParallelismRegion()) { }
+
+            V operator()(
+                const tbb::blocked_range<size_t> &r,
+                const V &value) const {
+                WORK_TRACE_RANGE_SCOPE(
+                    "WorkParallelReduceN chunk", r.begin(), r.end());
+                Work_ParallelismTaskScope regionScope(_region);
+                // Note that we std::forward _fn using Fn in order get the
+                // right operator().
+                // We maintain the right type in this way:
+                //  If Fn is T&, then reference collapsing gives us T& for _fn
+                //  If Fn is T, then std::forward correctly gives us T&& for _fn
+                return std::forward<Fn>(_fn)(r.begin(), r.end(), value);
+            }
+        private:
+            Fn &_fn;
+            Work_ParallelismRegionState *_region;
+        };
+
+        // In most cases we do not want to inherit cancellation state from the
+        // parent context, so we create an isolated task group context.
+        tbb::task_group_context ctx(tbb::task_group_context::isolated);
+        return tbb::parallel_reduce(tbb::blocked_range<size_t>(0,n,grainSize),
+            identity,
+            Work_Body_TBB(loopCallback),
+            std::forward<Rn>(reductionCallback),
+            partitioner,
+            ctx);
+    }
+        
+    // If concurrency is limited to 1, execute serially.
+    return std::forward<Fn>(loopCallback)(0, n, identity);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///     
 /// Recursively splits the range [0, \p n) into subranges, which are then
@@ -87,44 +152,115 @@ WorkParallelReduceN(
     Rn &&reductionCallback,
     size_t grainSize)
 {
-    if (n == 0)
-        return identity;
+    return Work_ParallelReduceN(identity, n,
+        std::forward<Fn>(loopCallback), std::forward<Rn>(reductionCallback),
+        grainSize, tbb::auto_partitioner());
+}
 
-    // Don't bother with parallel_reduce, if concurrency is limited to 1.
-    if (WorkHasConcurrency()) {
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+/// This overload uses \p partitioner to map subranges to the threads that
+/// reduced them in previous calls using the same partitioner.  See
+/// WorkAffinityPartitioner.
+///
+template <typename Fn, typename Rn, typename V>
+V
+WorkParallelReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback,
+    size_t grainSize,
+    WorkAffinityPartitioner &partitioner)
+{
+    return Work_ParallelReduceN(identity, n,
+        std::forward<Fn>(loopCallback), std::forward<Rn>(reductionCallback),
+        grainSize, Work_GetTbbPartitioner(partitioner));
+}
 
-        class Work_Body_TBB
-        {
-        public:
-            Work_Body_TBB(Fn &fn) : _fn(fn) { }
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+/// This overload splits the range evenly among the threads up front.  See
+/// WorkStaticPartitioner.
+///
+template <typename Fn, typename Rn, typename V>
+V
+WorkParallelReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback,
+    size_t grainSize,
+    WorkStaticPartitioner partitioner)
+{
+    return Work_ParallelReduceN(identity, n,
+        std::forward<Fn>(loopCallback), std::forward<Rn>(reductionCallback),
+        grainSize, Work_GetTbbPartitioner(partitioner));
+}
 
-            V operator()(
-                const tbb::blocked_range<size_t> &r,
-                const V &value) const {
-                // Note that we std::forward _fn using Fn in order get the
-                // right operator().
-                // We maintain the right type in this way:
-                //  If Fn is T&, then reference collapsing gives us T& for _fn
-                //  If Fn is T, then std::forward correctly gives us T&& for _fn
-                return std::forward<Fn>(_fn)(r.begin(), r.end(), value);
-            }
-        private:
-            Fn &_fn;
-        };
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+/// This overload stops early if \p token is cancelled: no further subranges
+/// are reduced, and the result only accounts for the subranges reduced until
+/// then, so it should be discarded.  If concurrency is limited to 1, the range
+/// is reduced serially in subranges of \p grainSize, checking \p token
+/// between them.  See WorkCancellationToken.
+///
+template <typename Fn, typename Rn, typename V>
+V
+WorkParallelReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback,
+    size_t grainSize,
+    const WorkCancellationToken &token)
+{
+    if (n == 0 || token.IsCancelled())
+        return identity;
 
-        // In most cases we do not want to inherit cancellation state from the
-        // parent context, so we create an isolated task group context.
+    WORK_TRACE_SCOPE("WorkParallelReduceN");
+
+    // Don't bother with parallel_reduce, if concurrency is limited to 1.
+    if (WorkHasConcurrency()) {
+        Work_ParallelismRegionState *region = Work_GetParallelismRegion();
         tbb::task_group_context ctx(tbb::task_group_context::isolated);
         return tbb::parallel_reduce(tbb::blocked_range<size_t>(0,n,grainSize),
             identity,
-            Work_Body_TBB(loopCallback),
+            [&loopCallback, &token, &ctx, region](
+                const tbb::blocked_range<size_t> &r, const V &value) -> V {
+                WORK_TRACE_RANGE_SCOPE(
+                    "WorkParallelReduceN chunk", r.begin(), r.end());
+                Work_ParallelismTaskScope regionScope(region);
+                // Cancelling the context stops the reduction from splitting.
+                if (token.IsCancelled()) {
+                    ctx.cancel_group_execution();
+                    return value;
+                }
+                return loopCallback(r.begin(), r.end(), value);
+            },
             std::forward<Rn>(reductionCallback),
             tbb::auto_partitioner(),
             ctx);
     }
-        
-    // If concurrency is limited to 1, execute serially.
-    return std::forward<Fn>(loopCallback)(0, n, identity);
+
+    // If concurrency is limited to 1, execute serially, in chunks so that
+    // cancellation is still noticed.
+    const size_t chunkSize = std::max<size_t>(grainSize, 1);
+    V value = identity;
+    for (size_t begin = 0; begin < n && !token.IsCancelled(); ) {
+        const size_t end = begin + std::min(chunkSize, n - begin);
+        WORK_TRACE_RANGE_SCOPE("WorkParallelReduceN chunk", begin, end);
+        value = loopCallback(begin, end, value);
+        begin = end;
+    }
+    return value;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -146,6 +282,131 @@ WorkParallelReduceN(
     return WorkParallelReduceN(identity, n, loopCallback, reductionCallback, 1);
 }
 
+// Reduces [begin, end) for WorkParallelDeterministicReduceN().  The range is
+// split in half until subranges are no larger than grainSize, the same way
+// whether the halves are reduced in parallel or not.  Only the outermost
+// split runs in ctx, nested ones run in the context of their parent task.
+// Subranges are attributed to the profiled parallelism region, if any.
+template <typename Fn, typename Rn, typename V>
+V
+Work_ParallelDeterministicReduce(
+    const V &identity,
+    size_t begin,
+    size_t end,
+    Fn &loopCallback,
+    Rn &reductionCallback,
+    size_t grainSize,
+    bool parallel,
+    tbb::task_group_context *ctx,
+    Work_ParallelismRegionState *region)
+{
+    if (end - begin <= grainSize) {
+        WORK_TRACE_RANGE_SCOPE(
+            "WorkParallelDeterministicReduceN chunk", begin, end);
+        Work_ParallelismTaskScope regionScope(region);
+        return std::forward<Fn>(loopCallback)(begin, end, identity);
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    V lhs(identity);
+    V rhs(identity);
+    auto reduceLhs = [&]() {
+        lhs = Work_ParallelDeterministicReduce<Fn, Rn>(identity, begin, mid,
+            loopCallback, reductionCallback, grainSize, parallel, nullptr,
+            region);
+    };
+    auto reduceRhs = [&]() {
+        rhs = Work_ParallelDeterministicReduce<Fn, Rn>(identity, mid, end,
+            loopCallback, reductionCallback, grainSize, parallel, nullptr,
+            region);
+    };
+
+    if (!parallel) {
+        reduceLhs();
+        reduceRhs();
+    } else if (ctx) {
+        tbb::parallel_invoke(reduceLhs, reduceRhs, *ctx);
+    } else {
+        tbb::parallel_invoke(reduceLhs, reduceRhs);
+    }
+    return std::forward<Rn>(reductionCallback)(lhs, rhs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// Like WorkParallelReduceN(), but guarantees that the result is the same from
+/// run to run, regardless of the concurrency limit and of how tasks are
+/// scheduled.
+///
+/// The range [0, \p n) is recursively split in halves until subranges contain
+/// at most \p grainSize elements.  \p loopCallback is invoked once for each of
+/// these subranges with \p identity, and the results of both halves of a
+/// range are always joined with \p reductionCallback as (lhs, rhs).  Since the
+/// shape of this tree only depends on \p n and \p grainSize, the exact same
+/// sequence of operations is applied to each value, which makes reductions
+/// that are not associative, such as floating-point sums, reproducible.  This
+/// holds even if concurrency is limited to 1, in which case the same tree is
+/// reduced serially.
+///
+/// This comes at the cost of load balancing: subranges are never merged to
+/// save on scheduling overhead, so \p grainSize should be large enough to
+/// amortize the cost of a task.
+///
+template <typename Fn, typename Rn, typename V>
+V
+WorkParallelDeterministicReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback,
+    size_t grainSize)
+{
+    if (n == 0)
+        return identity;
+
+    WORK_TRACE_SCOPE("WorkParallelDeterministicReduceN");
+
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    // Don't bother with parallel_invoke, if concurrency is limited to 1, but
+    // still reduce over the same tree.
+    const bool parallel = WorkHasConcurrency();
+
+    // In most cases we do not want to inherit cancellation state from the
+    // parent context, so we create an isolated task group context.
+    tbb::task_group_context ctx(tbb::task_group_context::isolated);
+    return Work_ParallelDeterministicReduce<Fn, Rn>(identity, 0, n,
+        loopCallback, reductionCallback, grainSize, parallel, &ctx,
+        Work_GetParallelismRegion());
+}
+
+// The maximum number of subranges WorkParallelDeterministicReduceN() splits
+// its range into when no grain size is given.
+constexpr size_t Work_DeterministicReduceMaxLeaves = 256;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+/// This overload does not accept a grain size parameter and instead derives
+/// one from \p n alone, splitting the range into at most a few hundred
+/// subranges, so that results do not depend on the machine.
+///
+template <typename Fn, typename Rn, typename V>
+V
+WorkParallelDeterministicReduceN(
+    const V &identity,
+    size_t n,
+    Fn &&loopCallback,
+    Rn &&reductionCallback)
+{
+    const size_t grainSize = (n + Work_DeterministicReduceMaxLeaves - 1) /
+        Work_DeterministicReduceMaxLeaves;
+    return WorkParallelDeterministicReduceN(identity, n,
+        std::forward<Fn>(loopCallback), std::forward<Rn>(reductionCallback),
+        grainSize);
+}
+
 }  // namespace pxr
 
 #endif // PXR_WORK_REDUCE_H
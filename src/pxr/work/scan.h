@@ -0,0 +1,294 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_SCAN_H
+#define PXR_WORK_SCAN_H
+
+/// \file work/scan.h
+#include "./threadLimits.h"
+#include "./api.h"
+#include "./parallelismProfile.h"
+#include "./tracing.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/task_group.h>
+
+#include <utility>
+
+namespace pxr {
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// Computes a parallel prefix scan over the range [0, \p n), such as running
+/// sums, and returns the value accumulated over the entire range.
+///
+/// The range is split into subranges that are scanned by invoking
+/// \p scanCallback, possibly twice per subrange: a first pre-scan pass may
+/// only compute the value accumulated over a subrange, so that the prefix of
+/// the following subranges is known, and a final pass produces the output
+/// given the exact prefix of the subrange.  The values accumulated over
+/// adjacent subranges are joined using \p combineCallback, which must be
+/// associative, and \p identity must be its identity element, since it may be
+/// used as the starting value of any number of subranges.
+///
+/// The \p scanCallback must be of the form:
+///
+///     V ScanCallback(size_t begin, size_t end, const V &prefix, bool isFinal);
+///
+/// It must return \p prefix joined with the elements of [begin, end), and
+/// only write its outputs when \p isFinal is true, in which case \p prefix is
+/// the value accumulated over [0, begin).
+///
+/// The \p combineCallback must be of the form:
+///
+///     V CombineCallback(const V &lhs, const V &rhs);
+///
+/// For example, the following code computes the offsets of variable-length
+/// arrays packed in a single buffer:
+///
+/// ```{.cpp}
+///
+/// const std::vector<size_t> &sizes = GetArraySizes();
+/// std::vector<size_t> offsets(sizes.size());
+///
+/// const size_t total = WorkParallelScanN(
+///     size_t(0),
+///     sizes.size(),
+///     [&](size_t b, size_t e, size_t prefix, bool isFinal) {
+///         for (size_t i = b; i != e; ++i) {
+///             if (isFinal) {
+///                 offsets[i] = prefix;
+///             }
+///             prefix += sizes[i];
+///         }
+///         return prefix;
+///     },
+///     [](size_t lhs, size_t rhs) {
+///         return lhs + rhs;
+///     },
+///     1024
+/// );
+///
+/// ```
+///
+/// \p grainSize specifies a minimum amount of work to be done per-thread.
+/// There is overhead to launching a task and a typical guideline is that
+/// you want to have at least 10,000 instructions to count for the overhead of
+/// launching that task.  Since elements may be visited twice, a parallel scan
+/// only pays off for large ranges.
+///
+template <typename Fn, typename Cn, typename V>
+V
+WorkParallelScanN(
+    const V &identity,
+    size_t n,
+    Fn &&scanCallback,
+    Cn &&combineCallback,
+    size_t grainSize)
+{
+    if (n == 0)
+        return identity;
+
+    WORK_TRACE_SCOPE("WorkParallelScanN");
+
+    // Don't bother with parallel_scan, if concurrency is limited to 1.
+    if (WorkHasConcurrency()) {
+
+        class Work_Body_TBB
+        {
+        public:
+            Work_Body_TBB(Fn &fn)
+                : _fn(fn), _region(Work_GetParallelismRegion()) { }
+
+            V operator()(
+                const tbb::blocked_range<size_t> &r,
+                const V &prefix,
+                bool isFinal) const {
+                WORK_TRACE_RANGE_SCOPE(
+                    "WorkParallelScanN chunk", r.begin(), r.end());
+                Work_ParallelismTaskScope regionScope(_region);
+                // Note that we std::forward _fn using Fn in order get the
+                // right operator().
+                // We maintain the right type in this way:
+                //  If Fn is T&, then reference collapsing gives us T& for _fn
+                //  If Fn is T, then std::forward correctly gives us T&& for _fn
+                return std::forward<Fn>(_fn)(
+                    r.begin(), r.end(), prefix, isFinal);
+            }
+        private:
+            Fn &_fn;
+            Work_ParallelismRegionState *_region;
+        };
+
+        const auto scan = [&]() {
+            return tbb::parallel_scan(
+                tbb::blocked_range<size_t>(0,n,grainSize),
+                identity,
+                Work_Body_TBB(scanCallback),
+                std::forward<Cn>(combineCallback));
+        };
+
+        // In most cases we do not want to inherit cancellation state from the
+        // parent context, since a partial scan would return a wrong result.
+        // Unlike the other algorithms, parallel_scan does not accept a task
+        // group context, so run it from a task bound to an isolated one.
+        V result = identity;
+        tbb::task_group_context ctx(tbb::task_group_context::isolated);
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+        tbb::task_group group(ctx);
+        group.run_and_wait([&result, &scan]() { result = scan(); });
+#else
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, 1),
+            [&result, &scan](const tbb::blocked_range<size_t> &) {
+                result = scan();
+            },
+            tbb::simple_partitioner(),
+            ctx);
+#endif
+        return result;
+    }
+
+    // If concurrency is limited to 1, execute serially.
+    return std::forward<Fn>(scanCallback)(0, n, identity, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+/// This overload does not accept a grain size parameter and instead attempts
+/// to automatically deduce a grain size that is optimal for the current
+/// resource utilization and provided workload.
+///
+template <typename Fn, typename Cn, typename V>
+V
+WorkParallelScanN(
+    const V &identity,
+    size_t n,
+    Fn &&scanCallback,
+    Cn &&combineCallback)
+{
+    return WorkParallelScanN(identity, n, scanCallback, combineCallback, 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// Writes to \p output[i] the join of \p identity with \p input[0] through
+/// \p input[i] using \p combineCallback, for each i in [0, \p n), and returns
+/// the join of all \p n inputs.  \p input and \p output are random access
+/// iterators, and may refer to the same elements.
+///
+/// The \p combineCallback must be associative, with \p identity as its
+/// identity element, and of the form:
+///
+///     V CombineCallback(const V &lhs, const V &rhs);
+///
+template <typename InputIt, typename OutputIt, typename Cn, typename V>
+V
+WorkParallelInclusiveScanN(
+    const V &identity,
+    size_t n,
+    InputIt input,
+    OutputIt output,
+    Cn &&combineCallback,
+    size_t grainSize)
+{
+    return WorkParallelScanN(identity, n,
+        [&input, &output, &combineCallback](
+            size_t begin, size_t end, const V &prefix, bool isFinal) {
+            V value(prefix);
+            for (size_t i = begin; i != end; ++i) {
+                value = combineCallback(value, V(input[i]));
+                if (isFinal) {
+                    output[i] = value;
+                }
+            }
+            return value;
+        },
+        combineCallback,
+        grainSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+template <typename InputIt, typename OutputIt, typename Cn, typename V>
+V
+WorkParallelInclusiveScanN(
+    const V &identity,
+    size_t n,
+    InputIt input,
+    OutputIt output,
+    Cn &&combineCallback)
+{
+    return WorkParallelInclusiveScanN(
+        identity, n, input, output, combineCallback, 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// Writes to \p output[i] the join of \p identity with \p input[0] through
+/// \p input[i - 1] using \p combineCallback, so that \p output[0] is
+/// \p identity, for each i in [0, \p n), and returns the join of all \p n
+/// inputs.  \p input and \p output are random access iterators, and may refer
+/// to the same elements.
+///
+/// The \p combineCallback must be associative, with \p identity as its
+/// identity element, and of the form:
+///
+///     V CombineCallback(const V &lhs, const V &rhs);
+///
+template <typename InputIt, typename OutputIt, typename Cn, typename V>
+V
+WorkParallelExclusiveScanN(
+    const V &identity,
+    size_t n,
+    InputIt input,
+    OutputIt output,
+    Cn &&combineCallback,
+    size_t grainSize)
+{
+    return WorkParallelScanN(identity, n,
+        [&input, &output, &combineCallback](
+            size_t begin, size_t end, const V &prefix, bool isFinal) {
+            V value(prefix);
+            for (size_t i = begin; i != end; ++i) {
+                // Read the input before writing the output, in case they
+                // refer to the same element.
+                V next = combineCallback(value, V(input[i]));
+                if (isFinal) {
+                    output[i] = value;
+                }
+                value = std::move(next);
+            }
+            return value;
+        },
+        combineCallback,
+        grainSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \overload
+///
+template <typename InputIt, typename OutputIt, typename Cn, typename V>
+V
+WorkParallelExclusiveScanN(
+    const V &identity,
+    size_t n,
+    InputIt input,
+    OutputIt output,
+    Cn &&combineCallback)
+{
+    return WorkParallelExclusiveScanN(
+        identity, n, input, output, combineCallback, 1);
+}
+
+}  // namespace pxr
+
+#endif // PXR_WORK_SCAN_H
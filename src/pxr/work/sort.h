@@ -10,10 +10,20 @@
 
 /// \file
 
+#include "./loops.h"
+#include "./parallelismProfile.h"
 #include "./threadLimits.h"
+#include "./tracing.h"
 
+#include <tbb/parallel_invoke.h>
 #include <tbb/parallel_sort.h>
 #include <algorithm>
+#include <array>
+#include <climits>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
 
 namespace pxr {
 
@@ -23,6 +33,7 @@ template <typename C>
 void 
 WorkParallelSort(C* container)
 {
+    WORK_TRACE_SCOPE("WorkParallelSort");
     // Don't bother with parallel_for, if concurrency is limited to 1.
     if (WorkHasConcurrency()) {
         tbb::parallel_sort(container->begin(), container->end());
@@ -39,6 +50,7 @@ template <typename C, typename Compare>
 void 
 WorkParallelSort(C* container, const Compare& comp)
 {
+    WORK_TRACE_SCOPE("WorkParallelSort");
     // Don't bother with parallel_for, if concurrency is limited to 1.
     if (WorkHasConcurrency()) {
         tbb::parallel_sort(container->begin(), container->end(), comp);
@@ -47,6 +59,314 @@ WorkParallelSort(C* container, const Compare& comp)
     }
 }
 
+// Ranges at or below this size are sorted or merged serially by
+// WorkParallelStableSort().
+constexpr size_t Work_StableSortCutoff = 4096;
+
+// Stably merges the sorted ranges [first1, last1) and [first2, last2) into
+// out, preferring elements of the first range over equivalent elements of the
+// second.  Elements are moved from the input ranges.  Serial merges are
+// attributed to the profiled parallelism region, if any.
+template <typename InIt, typename OutIt, typename Compare>
+void
+Work_ParallelMerge(
+    InIt first1, InIt last1, InIt first2, InIt last2, OutIt out,
+    const Compare &comp, Work_ParallelismRegionState *region)
+{
+    const size_t n1 = std::distance(first1, last1);
+    const size_t n2 = std::distance(first2, last2);
+    if (n1 + n2 <= Work_StableSortCutoff) {
+        WORK_TRACE_SCOPE("WorkParallelStableSort merge");
+        Work_ParallelismTaskScope regionScope(region);
+        std::merge(std::make_move_iterator(first1),
+                   std::make_move_iterator(last1),
+                   std::make_move_iterator(first2),
+                   std::make_move_iterator(last2),
+                   out, comp);
+        return;
+    }
+
+    // Split the larger range at its midpoint, and the other one where the
+    // midpoint would be inserted, such that equivalent elements of the first
+    // range still end up before those of the second.
+    InIt mid1, mid2;
+    if (n1 >= n2) {
+        mid1 = first1 + n1 / 2;
+        mid2 = std::lower_bound(first2, last2, *mid1, comp);
+    } else {
+        mid2 = first2 + n2 / 2;
+        mid1 = std::upper_bound(first1, last1, *mid2, comp);
+    }
+    OutIt outMid = out + (std::distance(first1, mid1) +
+                          std::distance(first2, mid2));
+
+    tbb::parallel_invoke(
+        [&]() {
+            Work_ParallelMerge(
+                first1, mid1, first2, mid2, out, comp, region);
+        },
+        [&]() {
+            Work_ParallelMerge(
+                mid1, last1, mid2, last2, outMid, comp, region);
+        });
+}
+
+// Stably sorts the elements of [xFirst, xLast).  The sorted result is left in
+// that range if inPlace is true, or moved into the range of the same length
+// starting at zFirst otherwise.  Subranges alternate between both ranges so
+// that each level merges from one into the other.  Serial sorts and merges
+// are attributed to the profiled parallelism region, if any.
+template <typename XIt, typename ZIt, typename Compare>
+void
+Work_ParallelStableSort(
+    XIt xFirst, XIt xLast, ZIt zFirst, bool inPlace, const Compare &comp,
+    Work_ParallelismRegionState *region)
+{
+    const size_t n = std::distance(xFirst, xLast);
+    if (n <= Work_StableSortCutoff) {
+        WORK_TRACE_SCOPE("WorkParallelStableSort sort");
+        Work_ParallelismTaskScope regionScope(region);
+        std::stable_sort(xFirst, xLast, comp);
+        if (!inPlace) {
+            std::move(xFirst, xLast, zFirst);
+        }
+        return;
+    }
+
+    const XIt xMid = xFirst + n / 2;
+    const ZIt zMid = zFirst + n / 2;
+    const ZIt zLast = zFirst + n;
+    tbb::parallel_invoke(
+        [&]() {
+            Work_ParallelStableSort(
+                xFirst, xMid, zFirst, !inPlace, comp, region);
+        },
+        [&]() {
+            Work_ParallelStableSort(
+                xMid, xLast, zMid, !inPlace, comp, region);
+        });
+
+    if (inPlace) {
+        Work_ParallelMerge(zFirst, zMid, zMid, zLast, xFirst, comp, region);
+    } else {
+        Work_ParallelMerge(xFirst, xMid, xMid, xLast, zFirst, comp, region);
+    }
+}
+
+/// Sorts in-place a container that provides random access begin() and end()
+/// methods, using a custom comparison functor, and preserving the relative
+/// order of equivalent elements.
+///
+/// This is a parallel merge sort.  It requires a temporary copy of the
+/// elements, and the element type must be move constructible and move
+/// assignable.
+///
+template <typename C, typename Compare>
+void
+WorkParallelStableSort(C* container, const Compare& comp)
+{
+    WORK_TRACE_SCOPE("WorkParallelStableSort");
+
+    using ValueType = typename std::iterator_traits<
+        decltype(container->begin())>::value_type;
+
+    const size_t n = std::distance(container->begin(), container->end());
+
+    // Don't bother with parallel_invoke, if concurrency is limited to 1.
+    if (!WorkHasConcurrency() || n <= Work_StableSortCutoff) {
+        std::stable_sort(container->begin(), container->end(), comp);
+        return;
+    }
+
+    // Sort from the temporary copy, so that the result of the final merge
+    // lands in the container.
+    std::vector<ValueType> tmp(std::make_move_iterator(container->begin()),
+                               std::make_move_iterator(container->end()));
+    Work_ParallelStableSort(
+        tmp.begin(), tmp.end(), container->begin(), /* inPlace = */ false,
+        comp, Work_GetParallelismRegion());
+}
+
+/// Sorts in-place a container that provides random access begin() and end()
+/// methods, preserving the relative order of equivalent elements.
+///
+template <typename C>
+void
+WorkParallelStableSort(C* container)
+{
+    WorkParallelStableSort(container, std::less<>());
+}
+
+// Ranges at or below this size are sorted with std::stable_sort by
+// WorkParallelRadixSort().
+constexpr size_t Work_RadixSortCutoff = 2048;
+
+// Number of elements processed by each task of a radix sort pass.
+constexpr size_t Work_RadixSortBlockSize = 16384;
+
+// Maps an integral key to an unsigned integer of the same width with the same
+// ordering.
+template <typename Key>
+typename std::make_unsigned<Key>::type
+Work_GetRadixSortKey(Key key)
+{
+    using UnsignedKey = typename std::make_unsigned<Key>::type;
+    UnsignedKey ukey = static_cast<UnsignedKey>(key);
+    if (std::is_signed<Key>::value) {
+        // Flip the sign bit so negative keys order before positive ones.
+        ukey ^= UnsignedKey(1) << (sizeof(Key) * CHAR_BIT - 1);
+    }
+    return ukey;
+}
+
+/// Sorts in-place a container that provides random access begin() and end()
+/// methods, by the integral key that \p getKey returns for each element.
+/// Elements with equal keys keep their relative order.
+///
+/// This is a least significant digit radix sort, which runs in time linear in
+/// the number of elements and the key size.  It is typically faster than a
+/// comparison sort for large containers, such as when ordering indices or
+/// handles by an integer.  Passes over digits that all keys share are
+/// skipped.  It requires a temporary copy of the elements, and the element
+/// type must be move constructible and move assignable.
+///
+/// \p getKey must be of the form:
+///
+///     Key GetKey(const ValueType &value);
+///
+/// where Key is a non-bool integral type.
+///
+template <typename C, typename GetKey>
+void
+WorkParallelRadixSort(C* container, const GetKey& getKey)
+{
+    WORK_TRACE_SCOPE("WorkParallelRadixSort");
+
+    using Iterator = decltype(container->begin());
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+    using Key = typename std::decay<
+        decltype(getKey(std::declval<const ValueType &>()))>::type;
+    static_assert(std::is_integral<Key>::value &&
+                  !std::is_same<Key, bool>::value,
+                  "WorkParallelRadixSort requires integral keys");
+
+    const Iterator first = container->begin();
+    const size_t n = std::distance(first, container->end());
+
+    // Don't bother with the radix sort, if concurrency is limited to 1.
+    if (!WorkHasConcurrency() || n <= Work_RadixSortCutoff) {
+        std::stable_sort(first, container->end(),
+            [&getKey](const ValueType &lhs, const ValueType &rhs) {
+                return getKey(lhs) < getKey(rhs);
+            });
+        return;
+    }
+
+    constexpr size_t numBuckets = 256;
+    constexpr size_t numPasses = sizeof(Key);
+    using Histogram = std::array<size_t, numBuckets>;
+
+    const size_t numBlocks =
+        (n + Work_RadixSortBlockSize - 1) / Work_RadixSortBlockSize;
+    std::vector<Histogram> offsets(numBlocks);
+    std::vector<ValueType> tmp(std::make_move_iterator(first),
+                               std::make_move_iterator(container->end()));
+
+    // Whether the current order of the elements is in tmp, rather than in
+    // the container.
+    bool inTmp = true;
+
+    for (size_t pass = 0; pass != numPasses; ++pass) {
+        const size_t shift = pass * 8;
+        const auto getDigit = [&getKey, shift](const ValueType &value) {
+            return (Work_GetRadixSortKey(getKey(value)) >> shift) & 0xff;
+        };
+
+        // Compute the histogram of digits of each block.
+        const auto countDigits = [&](auto src) {
+            WORK_TRACE_SCOPE("WorkParallelRadixSort histogram");
+            WorkParallelForN(numBlocks, [&](size_t begin, size_t end) {
+                for (size_t block = begin; block != end; ++block) {
+                    Histogram &counts = offsets[block];
+                    counts.fill(0);
+                    const size_t blockEnd = std::min(
+                        n, (block + 1) * Work_RadixSortBlockSize);
+                    for (size_t i = block * Work_RadixSortBlockSize;
+                         i != blockEnd; ++i) {
+                        ++counts[getDigit(src[i])];
+                    }
+                }
+            }, 1);
+        };
+        if (inTmp) {
+            countDigits(tmp.begin());
+        } else {
+            countDigits(first);
+        }
+
+        // Turn the counts into the offset at which each block writes its
+        // first element of each digit, ordered by digit then by block.
+        size_t offset = 0;
+        bool skipPass = false;
+        for (size_t digit = 0; digit != numBuckets; ++digit) {
+            const size_t digitBegin = offset;
+            for (size_t block = 0; block != numBlocks; ++block) {
+                const size_t count = offsets[block][digit];
+                offsets[block][digit] = offset;
+                offset += count;
+            }
+            if (offset - digitBegin == n) {
+                skipPass = true;
+                break;
+            }
+        }
+        if (skipPass) {
+            continue;
+        }
+
+        // Scatter the elements of each block to their offsets.
+        const auto scatter = [&](auto src, auto dst) {
+            WORK_TRACE_SCOPE("WorkParallelRadixSort scatter");
+            WorkParallelForN(numBlocks, [&](size_t begin, size_t end) {
+                for (size_t block = begin; block != end; ++block) {
+                    Histogram &blockOffsets = offsets[block];
+                    const size_t blockEnd = std::min(
+                        n, (block + 1) * Work_RadixSortBlockSize);
+                    for (size_t i = block * Work_RadixSortBlockSize;
+                         i != blockEnd; ++i) {
+                        dst[blockOffsets[getDigit(src[i])]++] =
+                            std::move(src[i]);
+                    }
+                }
+            }, 1);
+        };
+        if (inTmp) {
+            scatter(tmp.begin(), first);
+        } else {
+            scatter(first, tmp.begin());
+        }
+        inTmp = !inTmp;
+    }
+
+    if (inTmp) {
+        WorkParallelForN(n, [&](size_t begin, size_t end) {
+            std::move(tmp.begin() + begin, tmp.begin() + end, first + begin);
+        });
+    }
+}
+
+/// Sorts in-place a container of non-bool integral values that provides
+/// random access begin() and end() methods, using a parallel radix sort.
+///
+template <typename C>
+void
+WorkParallelRadixSort(C* container)
+{
+    using ValueType = typename std::iterator_traits<
+        decltype(container->begin())>::value_type;
+    WorkParallelRadixSort(container, [](ValueType value) { return value; });
+}
+
 }  // namespace pxr
 
 #endif
@@ -0,0 +1,149 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./taskGraph.h"
+
+#include <pxr/arch/timing.h>
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace pxr {
+
+static constexpr WorkTaskGraph::NodeId _noNode =
+    std::numeric_limits<WorkTaskGraph::NodeId>::max();
+
+WorkTaskGraph::WorkTaskGraph()
+    : _criticalPathLength(0)
+    , _numAllocated(0)
+    , _executed(false)
+{
+}
+
+WorkTaskGraph::~WorkTaskGraph() = default;
+
+size_t
+WorkTaskGraph::GetNumNodes() const
+{
+    return _nodes.size();
+}
+
+void
+WorkTaskGraph::Clear()
+{
+    _nodes.clear();
+    _roots.clear();
+    _criticalPathLength = 0;
+    _executed = false;
+}
+
+WorkTaskGraph::NodeId
+WorkTaskGraph::_AddNode(std::function<void ()> &&fn,
+                        const std::vector<NodeId> &predecessors)
+{
+    const NodeId id = _nodes.size();
+
+    _Node node { std::move(fn), {}, {}, 1 };
+    node.predecessors.reserve(predecessors.size());
+    for (NodeId pred : predecessors) {
+        if (pred >= id) {
+            TF_CODING_ERROR("Invalid predecessor %zu for node %zu", pred, id);
+            continue;
+        }
+        node.predecessors.push_back(pred);
+        _nodes[pred].successors.push_back(id);
+        node.depth = std::max(node.depth, _nodes[pred].depth + 1);
+    }
+
+    if (node.predecessors.empty()) {
+        _roots.push_back(id);
+    }
+    _criticalPathLength = std::max(_criticalPathLength, node.depth);
+    _nodes.push_back(std::move(node));
+    _executed = false;
+    return id;
+}
+
+void
+WorkTaskGraph::Execute()
+{
+    const size_t numNodes = _nodes.size();
+    if (numNodes > _numAllocated) {
+        _pending.reset(new std::atomic<size_t>[numNodes]);
+        _ticks.resize(numNodes);
+        _numAllocated = numNodes;
+    }
+
+    for (NodeId i = 0; i != numNodes; ++i) {
+        _pending[i].store(
+            _nodes[i].predecessors.size(), std::memory_order_relaxed);
+    }
+
+    for (NodeId root : _roots) {
+        _dispatcher.Run(_RunNodeTask { this, root });
+    }
+    _dispatcher.Wait();
+    _executed = true;
+}
+
+void
+WorkTaskGraph::_RunNode(NodeId node)
+{
+    while (true) {
+        const uint64_t startTicks = ArchGetTickTime();
+        _nodes[node].fn();
+        _ticks[node] = ArchGetTickTime() - startTicks;
+
+        // Continue with the first successor that becomes ready on this
+        // thread, rather than going through the dispatcher, and run the
+        // others as new tasks.
+        NodeId next = _noNode;
+        for (NodeId succ : _nodes[node].successors) {
+            if (_pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (next == _noNode) {
+                    next = succ;
+                }
+                else {
+                    _dispatcher.Run(_RunNodeTask { this, succ });
+                }
+            }
+        }
+        if (next == _noNode) {
+            return;
+        }
+        node = next;
+    }
+}
+
+size_t
+WorkTaskGraph::GetCriticalPathLength() const
+{
+    return _criticalPathLength;
+}
+
+double
+WorkTaskGraph::GetLastCriticalPathSeconds() const
+{
+    if (!_executed) {
+        return 0.0;
+    }
+
+    // Nodes are added after their predecessors, so a single pass in order
+    // finds the costliest chain ending at each node.
+    std::vector<uint64_t> pathTicks(_nodes.size());
+    uint64_t maxTicks = 0;
+    for (NodeId i = 0; i != _nodes.size(); ++i) {
+        uint64_t predTicks = 0;
+        for (NodeId pred : _nodes[i].predecessors) {
+            predTicks = std::max(predTicks, pathTicks[pred]);
+        }
+        pathTicks[i] = predTicks + _ticks[i];
+        maxTicks = std::max(maxTicks, pathTicks[i]);
+    }
+    return ArchTicksToNanoseconds(maxTicks) / 1e9;
+}
+
+}  // namespace pxr
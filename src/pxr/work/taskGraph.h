@@ -0,0 +1,134 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_TASK_GRAPH_H
+#define PXR_WORK_TASK_GRAPH_H
+
+/// \file work/taskGraph.h
+
+#include "./api.h"
+#include "./dispatcher.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pxr {
+
+/// \class WorkTaskGraph
+///
+/// A WorkTaskGraph runs tasks with dependencies between them.  Each node of
+/// the graph runs as soon as all of its predecessors have completed, and
+/// concurrently with any other node whose predecessors have completed.
+///
+/// Nodes are added along with the nodes they depend on, which must already be
+/// in the graph.  This guarantees that the graph has no cycles.  Once built,
+/// a graph may be executed any number of times, for example once per frame,
+/// without allocating storage for its nodes again.
+///
+/// For example,
+///
+/// \code
+/// WorkTaskGraph graph;
+/// const WorkTaskGraph::NodeId load = graph.AddNode(LoadScene);
+/// const WorkTaskGraph::NodeId xforms = graph.AddNode(ComputeXforms, {load});
+/// const WorkTaskGraph::NodeId bounds = graph.AddNode(ComputeBounds, {load});
+/// graph.AddNode(Cull, {xforms, bounds});
+///
+/// for (int frame = 0; frame != numFrames; ++frame) {
+///     graph.Execute();
+/// }
+/// \endcode
+///
+/// Errors posted by nodes are transported to the thread that calls
+/// Execute(), as with WorkDispatcher.  A graph must not be modified or
+/// executed while it is executing.
+///
+class WorkTaskGraph
+{
+public:
+    /// Identifies a node of the graph, in the order nodes were added.
+    using NodeId = size_t;
+
+    WORK_API WorkTaskGraph();
+    WORK_API ~WorkTaskGraph();
+
+    WorkTaskGraph(WorkTaskGraph const &) = delete;
+    WorkTaskGraph &operator=(WorkTaskGraph const &) = delete;
+
+    /// Add a node that invokes \p fn once each time the graph executes, after
+    /// all the nodes in \p predecessors have completed.  Return the id of the
+    /// new node.
+    ///
+    /// Callable must be of the form:
+    ///
+    ///     void Callable();
+    ///
+    template <class Callable>
+    NodeId AddNode(Callable &&fn, const std::vector<NodeId> &predecessors = {}) {
+        return _AddNode(std::function<void ()>(std::forward<Callable>(fn)),
+                        predecessors);
+    }
+
+    /// Return the number of nodes in the graph.
+    WORK_API size_t GetNumNodes() const;
+
+    /// Remove all nodes from the graph.
+    WORK_API void Clear();
+
+    /// Run all the nodes of the graph, respecting their dependencies, and wait
+    /// for them to complete.
+    WORK_API void Execute();
+
+    /// Return the number of nodes on the longest chain of dependent nodes in
+    /// the graph.  This bounds how fast the graph can execute regardless of
+    /// the number of threads.
+    WORK_API size_t GetCriticalPathLength() const;
+
+    /// Return the time, in seconds, spent running the nodes on the costliest
+    /// chain of dependent nodes during the last Execute(), or 0 if the graph
+    /// was not executed since it was last modified.  Comparing this with the
+    /// time Execute() took shows how much parallelism the graph exposes.
+    WORK_API double GetLastCriticalPathSeconds() const;
+
+private:
+    struct _Node {
+        std::function<void ()> fn;
+        std::vector<NodeId> predecessors;
+        std::vector<NodeId> successors;
+        // Number of nodes on the longest chain ending with this node.
+        size_t depth;
+    };
+
+    struct _RunNodeTask {
+        void operator()() const { graph->_RunNode(node); }
+        WorkTaskGraph *graph;
+        NodeId node;
+    };
+
+    WORK_API NodeId _AddNode(std::function<void ()> &&fn,
+                             const std::vector<NodeId> &predecessors);
+
+    void _RunNode(NodeId node);
+
+    std::vector<_Node> _nodes;
+    std::vector<NodeId> _roots;
+    size_t _criticalPathLength;
+
+    // Per-execution state, only reallocated when nodes are added.
+    std::unique_ptr<std::atomic<size_t>[]> _pending;
+    std::vector<uint64_t> _ticks;
+    size_t _numAllocated;
+    bool _executed;
+
+    WorkDispatcher _dispatcher;
+};
+
+}  // namespace pxr
+
+#endif // PXR_WORK_TASK_GRAPH_H
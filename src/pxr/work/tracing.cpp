@@ -0,0 +1,46 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include "./tracing.h"
+
+#include <pxr/tf/envSetting.h>
+#include <pxr/trace/collector.h>
+
+#include <cstdint>
+
+TF_DEFINE_ENV_SETTING(
+    PXR_WORK_ENABLE_TRACE, false,
+    "Record trace events for dispatcher tasks, detached tasks, parallel loop "
+    "chunks and parallel sort phases.");
+
+namespace pxr {
+
+std::atomic<bool> Work_TraceEnabled {
+    TfGetEnvSetting(PXR_WORK_ENABLE_TRACE) };
+
+bool
+WorkIsTraceEnabled()
+{
+    return Work_TraceEnabled.load(std::memory_order_relaxed);
+}
+
+void
+WorkSetTraceEnabled(bool enabled)
+{
+    Work_TraceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void
+Work_StoreTraceRange(size_t begin, size_t end)
+{
+    static constexpr TraceStaticKeyData beginKey("begin");
+    static constexpr TraceStaticKeyData endKey("end");
+
+    TraceCollector &collector = TraceCollector::GetInstance();
+    collector.StoreData(beginKey, static_cast<uint64_t>(begin));
+    collector.StoreData(endKey, static_cast<uint64_t>(end));
+}
+
+}  // namespace pxr
@@ -0,0 +1,88 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#ifndef PXR_WORK_TRACING_H
+#define PXR_WORK_TRACING_H
+
+/// \file work/tracing.h
+
+#include "./api.h"
+
+#include <pxr/arch/hints.h>
+#include <pxr/tf/preprocessorUtilsLite.h>
+#include <pxr/trace/trace.h>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace pxr {
+
+/// Return true if Work primitives record trace events.
+///
+/// When enabled, and while the TraceCollector is enabled, dispatcher tasks,
+/// detached tasks, the chunks of parallel loops and reductions, along with
+/// their range, and the phases of parallel sorts are recorded as trace
+/// scopes.  Since events are recorded on the thread that runs them, traces
+/// show how work is distributed across threads and where threads are idle.
+///
+/// This defaults to the value of the PXR_WORK_ENABLE_TRACE environment
+/// variable.  It is disabled by default because tasks and chunks may be small
+/// enough that recording them, even when the collector is disabled, would be
+/// a measurable overhead.
+WORK_API bool WorkIsTraceEnabled();
+
+/// Enable or disable the recording of trace events by Work primitives.
+WORK_API void WorkSetTraceEnabled(bool enabled);
+
+// Whether trace events are recorded, read by every traced scope.
+extern WORK_API std::atomic<bool> Work_TraceEnabled;
+
+// Record the range of the enclosing trace scope.
+WORK_API void Work_StoreTraceRange(size_t begin, size_t end);
+
+// A trace scope that is only recorded if Work tracing is enabled.
+class Work_TraceScope
+{
+public:
+    explicit Work_TraceScope(const TraceStaticKeyData &key) {
+        if (ARCH_UNLIKELY(Work_TraceEnabled.load(std::memory_order_relaxed))) {
+            _scope.emplace(key);
+        }
+    }
+
+    Work_TraceScope(const TraceStaticKeyData &key, size_t begin, size_t end)
+        : Work_TraceScope(key) {
+        if (ARCH_UNLIKELY(_scope)) {
+            Work_StoreTraceRange(begin, end);
+        }
+    }
+
+    Work_TraceScope(Work_TraceScope const &) = delete;
+    Work_TraceScope &operator=(Work_TraceScope const &) = delete;
+
+private:
+    std::optional<TraceScopeAuto> _scope;
+};
+
+}  // namespace pxr
+
+// Record a trace scope named name for the rest of the enclosing block, if
+// Work tracing is enabled.
+#define WORK_TRACE_SCOPE(name) \
+    static constexpr ::pxr::TraceStaticKeyData \
+        TF_PP_CAT(Work_TraceKey_, __LINE__)(name); \
+    ::pxr::Work_TraceScope TF_PP_CAT(Work_TraceScope_, __LINE__)( \
+        TF_PP_CAT(Work_TraceKey_, __LINE__))
+
+// Like WORK_TRACE_SCOPE(), but also record the range [begin, end) processed
+// by the scope.
+#define WORK_TRACE_RANGE_SCOPE(name, begin, end) \
+    static constexpr ::pxr::TraceStaticKeyData \
+        TF_PP_CAT(Work_TraceKey_, __LINE__)(name); \
+    ::pxr::Work_TraceScope TF_PP_CAT(Work_TraceScope_, __LINE__)( \
+        TF_PP_CAT(Work_TraceKey_, __LINE__), (begin), (end))
+
+#endif // PXR_WORK_TRACING_H
@@ -8,6 +8,10 @@
 #include "./utils.h"
 #include <pxr/tf/envSetting.h>
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 namespace pxr {
 
 TF_DEFINE_ENV_SETTING(WORK_SYNCHRONIZE_ASYNC_DESTROY_CALLS, false,
@@ -21,4 +25,63 @@ Work_ShouldSynchronizeAsyncDestroyCalls()
     return TfGetEnvSetting(WORK_SYNCHRONIZE_ASYNC_DESTROY_CALLS);
 }
 
+namespace {
+
+// The deferred destruction buffers of all threads.  The mutex is recursive
+// since flushing buffers may destroy objects synchronously, which may in turn
+// create buffers on the flushing thread.
+struct _DeferredDestroyRegistry
+{
+    std::recursive_mutex mutex;
+    std::vector<Work_DeferredDestroyBufferBase *> buffers;
+};
+
+} // anonymous namespace
+
+static _DeferredDestroyRegistry &
+_GetDeferredDestroyRegistry()
+{
+    // Deliberately leaked, since buffers may be destroyed by threads exiting
+    // after main().
+    static _DeferredDestroyRegistry *registry = new _DeferredDestroyRegistry;
+    return *registry;
+}
+
+Work_DeferredDestroyBufferBase::Work_DeferredDestroyBufferBase()
+{
+    _DeferredDestroyRegistry &registry = _GetDeferredDestroyRegistry();
+    std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+    registry.buffers.push_back(this);
+}
+
+Work_DeferredDestroyBufferBase::~Work_DeferredDestroyBufferBase()
+{
+    _Unregister();
+}
+
+void
+Work_DeferredDestroyBufferBase::_Unregister()
+{
+    _DeferredDestroyRegistry &registry = _GetDeferredDestroyRegistry();
+    std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+    registry.buffers.erase(
+        std::remove(registry.buffers.begin(), registry.buffers.end(), this),
+        registry.buffers.end());
+}
+
+void
+WorkFlushDeferredDestroys()
+{
+    // Hold the lock while flushing, so that buffers of exiting threads are
+    // not destroyed meanwhile.  Iterate over a copy, since destroying objects
+    // synchronously may create buffers on this thread.
+    _DeferredDestroyRegistry &registry = _GetDeferredDestroyRegistry();
+    std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+    const std::vector<Work_DeferredDestroyBufferBase *> buffers =
+        registry.buffers;
+    for (Work_DeferredDestroyBufferBase *buffer : buffers) {
+        buffer->Flush();
+    }
+}
+
 }  // namespace pxr
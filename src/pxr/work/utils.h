@@ -12,8 +12,15 @@
 
 #include "./api.h"
 #include "./detachedTask.h"
+#include "./loops.h"
 
+#include <tbb/spin_mutex.h>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace pxr {
 
@@ -62,24 +69,278 @@ struct Work_AsyncSwapDestroyHelper {
 /// be true, for example, if obj's destructor might try to update some other
 /// data structure that could be destroyed by the time obj's destruction occurs.
 /// Be careful.
+///
+/// \p estimatedBytes is an estimate of the memory released by destroying
+/// \p obj, which counts toward the limits set by WorkSetDetachedTaskLimits().
+/// \p obj is destroyed synchronously if those limits are reached.
 template <class T>
-void WorkSwapDestroyAsync(T &obj)
+void WorkSwapDestroyAsync(T &obj, size_t estimatedBytes)
 {
     using std::swap;
     Work_AsyncSwapDestroyHelper<T> helper;
     swap(helper.obj, obj);
     if (!Work_ShouldSynchronizeAsyncDestroyCalls())
-        WorkRunDetachedTask(std::move(helper));
+        WorkRunDetachedTask(std::move(helper), estimatedBytes);
+}
+
+/// \overload
+template <class T>
+void WorkSwapDestroyAsync(T &obj)
+{
+    WorkSwapDestroyAsync(obj, 0);
 }
 
 /// Like WorkSwapDestroyAsync() but instead, move from \p obj, leaving it
 /// in a moved-from state instead of a default constructed state.
 template <class T>
-void WorkMoveDestroyAsync(T &obj)
+void WorkMoveDestroyAsync(T &obj, size_t estimatedBytes)
 {
     Work_AsyncMoveDestroyHelper<T> helper { std::move(obj) };
     if (!Work_ShouldSynchronizeAsyncDestroyCalls())
-        WorkRunDetachedTask(std::move(helper));
+        WorkRunDetachedTask(std::move(helper), estimatedBytes);
+}
+
+/// \overload
+template <class T>
+void WorkMoveDestroyAsync(T &obj)
+{
+    WorkMoveDestroyAsync(obj, 0);
+}
+
+// Objects are sent for destruction as a single detached task once a thread's
+// deferred destruction buffer for their type holds this many objects, or this
+// many estimated bytes.
+constexpr size_t Work_DeferredDestroyMaxCount = 1024;
+constexpr size_t Work_DeferredDestroyMaxBytes = size_t(1) << 20;
+
+// Base class for the per-thread, per-type deferred destruction buffers.
+// Buffers register themselves in a process-wide registry, so that
+// WorkFlushDeferredDestroys() can flush the buffers of all threads, including
+// those of worker threads that live as long as the process.
+class Work_DeferredDestroyBufferBase
+{
+public:
+    WORK_API Work_DeferredDestroyBufferBase();
+    WORK_API virtual ~Work_DeferredDestroyBufferBase();
+
+    // Send the buffered objects for destruction.  This may be called from
+    // any thread.
+    virtual void Flush() = 0;
+
+protected:
+    // Remove this buffer from the registry, so that it is no longer flushed
+    // by other threads.  Derived classes must call this before destroying
+    // their members.
+    WORK_API void _Unregister();
+};
+
+template <class T>
+class Work_DeferredDestroyBuffer : public Work_DeferredDestroyBufferBase
+{
+public:
+    ~Work_DeferredDestroyBuffer() override {
+        _Unregister();
+        Flush();
+    }
+
+    void Add(T &&obj, size_t estimatedBytes) {
+        bool full;
+        {
+            tbb::spin_mutex::scoped_lock lock(_mutex);
+            _objects.push_back(std::move(obj));
+            _estimatedBytes += estimatedBytes;
+            full = _objects.size() >= Work_DeferredDestroyMaxCount ||
+                _estimatedBytes >= Work_DeferredDestroyMaxBytes;
+        }
+        if (full) {
+            Flush();
+        }
+    }
+
+    void Flush() override {
+        // Take the objects out of the buffer first, in case destroying them
+        // synchronously defers more objects of the same type.
+        std::vector<T> objects;
+        size_t estimatedBytes;
+        {
+            tbb::spin_mutex::scoped_lock lock(_mutex);
+            if (_objects.empty()) {
+                return;
+            }
+            objects.swap(_objects);
+            estimatedBytes = _estimatedBytes;
+            _estimatedBytes = 0;
+        }
+        WorkMoveDestroyAsync(objects, estimatedBytes);
+    }
+
+private:
+    tbb::spin_mutex _mutex;
+    std::vector<T> _objects;
+    size_t _estimatedBytes = 0;
+};
+
+/// Like WorkMoveDestroyAsync(), but rather than creating a detached task for
+/// each object, collect \p obj in a buffer owned by the calling thread.  The
+/// buffered objects are destroyed together in a single detached task once the
+/// buffer holds enough objects or estimated bytes, when
+/// WorkFlushDeferredDestroys() is called, or when this thread exits.
+///
+/// This amortizes the cost of scheduling over many small objects.  In
+/// exchange, objects may be destroyed arbitrarily late if the thread does not
+/// defer more objects and WorkFlushDeferredDestroys() is not called, which
+/// matters for worker threads since they live as long as the process.  Call
+/// WorkFlushDeferredDestroys() at points where buffered objects should be
+/// released, and prefer WorkMoveDestroyAsync() for objects holding scarce
+/// resources.
+template <class T>
+void WorkDeferredMoveDestroyAsync(T &obj, size_t estimatedBytes)
+{
+    if (Work_ShouldSynchronizeAsyncDestroyCalls()) {
+        T destroyed(std::move(obj));
+        return;
+    }
+    static thread_local Work_DeferredDestroyBuffer<T> buffer;
+    buffer.Add(std::move(obj), estimatedBytes);
+}
+
+/// \overload
+template <class T>
+void WorkDeferredMoveDestroyAsync(T &obj)
+{
+    WorkDeferredMoveDestroyAsync(obj, 0);
+}
+
+/// Send all objects collected by WorkDeferredMoveDestroyAsync(), on any
+/// thread, for destruction.
+WORK_API
+void WorkFlushDeferredDestroys();
+
+/// Move all the elements out of \p container and arrange for them to be
+/// destroyed asynchronously in a single detached task, leaving \p container
+/// empty.  This is intended for containers of owners, such as vectors of
+/// smart pointers, whose elements would otherwise each be destroyed with
+/// WorkMoveDestroyAsync().  See WorkSwapDestroyAsync() for the restrictions
+/// on the elements' destructors.
+///
+/// \p estimatedBytes is an estimate of the memory released by destroying the
+/// elements, which counts toward the limits set by
+/// WorkSetDetachedTaskLimits().  It must account for the memory the elements
+/// own, such as the objects smart pointers point to, since the size of the
+/// elements themselves is usually negligible.
+template <class C>
+void WorkDestroyAsyncBatch(C &container, size_t estimatedBytes)
+{
+    WorkMoveDestroyAsync(container, estimatedBytes);
+    // Moved-from containers are valid but unspecified.
+    container.clear();
+}
+
+// Containers with fewer elements than this are destroyed serially by
+// WorkParallelMoveDestroyAsync().
+constexpr size_t Work_ParallelDestroyMinSize = 4096;
+
+// Detects unordered associative containers, whose mapped values can be reset
+// bucket by bucket.
+template <class T, class = void>
+struct Work_IsUnorderedMap : std::false_type {};
+
+template <class T>
+struct Work_IsUnorderedMap<T, std::void_t<
+    typename T::mapped_type,
+    decltype(std::declval<T &>().bucket_count()),
+    decltype(std::declval<T &>().begin(size_t()))>> : std::true_type {};
+
+// Detects containers with random access iterators, whose elements can be
+// reset by index.
+template <class T, class = void>
+struct Work_IsRandomAccessContainer : std::false_type {};
+
+template <class T>
+struct Work_IsRandomAccessContainer<T, std::void_t<
+    decltype(std::declval<T &>().begin())>> : std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<
+            decltype(std::declval<T &>().begin())>::iterator_category> {};
+
+// Resets the elements of a container in parallel, releasing the resources
+// they hold, so that only the container's own storage is left to free
+// serially.
+template <class T>
+void
+Work_ParallelResetElements(T &obj)
+{
+    if constexpr (Work_IsUnorderedMap<T>::value) {
+        using MappedType = typename T::mapped_type;
+        if (std::is_trivially_destructible<MappedType>::value ||
+            obj.size() < Work_ParallelDestroyMinSize) {
+            return;
+        }
+        WorkParallelForN(obj.bucket_count(), [&obj](size_t begin, size_t end) {
+            for (size_t bucket = begin; bucket != end; ++bucket) {
+                for (auto it = obj.begin(bucket), e = obj.end(bucket);
+                     it != e; ++it) {
+                    it->second = MappedType();
+                }
+            }
+        });
+    }
+    else if constexpr (Work_IsRandomAccessContainer<T>::value) {
+        using ValueType = typename std::iterator_traits<
+            decltype(obj.begin())>::value_type;
+        // Trivially destructible elements hold nothing to release, and
+        // writing to them concurrently is unsafe for proxies, like those of
+        // std::vector<bool>.
+        const size_t size = std::distance(obj.begin(), obj.end());
+        if (std::is_trivially_destructible<ValueType>::value ||
+            size < Work_ParallelDestroyMinSize) {
+            return;
+        }
+        WorkParallelForN(size, [&obj](size_t begin, size_t end) {
+            auto it = obj.begin() + begin;
+            for (size_t i = begin; i != end; ++i, ++it) {
+                *it = ValueType();
+            }
+        });
+    }
+}
+
+template <class T>
+struct Work_AsyncParallelMoveDestroyHelper {
+    void operator()() const { Work_ParallelResetElements(obj); }
+    mutable T obj;
+};
+
+/// Like WorkMoveDestroyAsync(), but for large containers, destroy the
+/// elements by parallel chunks with WorkParallelForN() rather than serially
+/// in a single task.
+///
+/// This supports containers with random access iterators, such as
+/// std::vector, and unordered maps, such as std::unordered_map, for which the
+/// mapped values are destroyed in parallel, bucket by bucket.  Elements or
+/// mapped values are destroyed by assigning them a value-initialized
+/// instance, so they must be default constructible and move assignable, and
+/// the container's own storage is still freed serially.  Other types, and
+/// containers with fewer than a few thousand elements, are destroyed
+/// serially, as with WorkMoveDestroyAsync().
+///
+/// This is worthwhile when the elements themselves own memory, such as
+/// vectors of arrays or maps to large objects.
+template <class T>
+void WorkParallelMoveDestroyAsync(T &obj, size_t estimatedBytes)
+{
+    Work_AsyncParallelMoveDestroyHelper<T> helper { std::move(obj) };
+    if (!Work_ShouldSynchronizeAsyncDestroyCalls())
+        WorkRunDetachedTask(std::move(helper), estimatedBytes);
+    else
+        helper();
+}
+
+/// \overload
+template <class T>
+void WorkParallelMoveDestroyAsync(T &obj)
+{
+    WorkParallelMoveDestroyAsync(obj, 0);
 }
 
 }  // namespace pxr
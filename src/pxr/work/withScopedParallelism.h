@@ -12,6 +12,7 @@
 
 #include "./api.h"
 #include "./dispatcher.h"
+#include "./parallelismProfile.h"
 #include <pxr/tf/pyLock.h>
 
 #include <tbb/task_arena.h>
@@ -108,6 +109,21 @@ WorkWithScopedParallelism(Fn &&fn, bool dropPythonGIL=true)
     }
 }
 
+/// Similar to WorkWithScopedParallelism(), but profile the invocation as the
+/// region \p name when WorkIsParallelismProfilingEnabled() is true.  Since the
+/// calling thread only takes tasks from within the region while it waits,
+/// regions that do not expose enough parallelism can leave threads idle.  The
+/// efficiency of each region is reported by WorkGetParallelismProfile().  \p
+/// name must remain valid until the function returns.
+template <class Fn>
+auto
+WorkWithNamedScopedParallelism(
+    const char *name, Fn &&fn, bool dropPythonGIL=true)
+{
+    Work_ParallelismRegion region(name);
+    return WorkWithScopedParallelism(std::forward<Fn>(fn), dropPythonGIL);
+}
+
 /// Similar to WorkWithScopedParallelism(), but pass a WorkDispatcher instance
 /// to \p fn for its use during the scoped parallelism.  Accordingly, \p fn must
 /// accept a WorkDispatcher lvalue reference argument.  After \p fn returns but
@@ -11,5 +11,7 @@ using namespace pxr;
 
 TF_WRAP_MODULE
 {
+    TF_WRAP(DispatcherStats);
+    TF_WRAP(ParallelismProfile);
     TF_WRAP(ThreadLimits);
 }
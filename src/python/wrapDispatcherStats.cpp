@@ -0,0 +1,64 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/dispatcherStats.h>
+
+#include <pxr/boost/python/class.hpp>
+#include <pxr/boost/python/def.hpp>
+#include <pxr/boost/python/list.hpp>
+
+using namespace pxr;
+
+using namespace pxr::boost::python;
+
+namespace {
+
+list
+_HistogramToList(const WorkDispatcherStats::Histogram &histogram)
+{
+    list result;
+    for (size_t count : histogram) {
+        result.append(count);
+    }
+    return result;
+}
+
+list
+_GetQueueNanosecondsHistogram(const WorkDispatcherStats &stats)
+{
+    return _HistogramToList(stats.queueNanosecondsHistogram);
+}
+
+list
+_GetRunNanosecondsHistogram(const WorkDispatcherStats &stats)
+{
+    return _HistogramToList(stats.runNanosecondsHistogram);
+}
+
+} // anonymous namespace
+
+void wrapDispatcherStats()
+{
+    class_<WorkDispatcherStats>("DispatcherStats", no_init)
+        .def_readonly("numTasksSubmitted",
+                      &WorkDispatcherStats::numTasksSubmitted)
+        .def_readonly("numTasksStarted",
+                      &WorkDispatcherStats::numTasksStarted)
+        .def_readonly("numTasksCompleted",
+                      &WorkDispatcherStats::numTasksCompleted)
+        .def_readonly("numWaits", &WorkDispatcherStats::numWaits)
+        .def_readonly("waitNanoseconds",
+                      &WorkDispatcherStats::waitNanoseconds)
+        .add_property("queueNanosecondsHistogram",
+                      &_GetQueueNanosecondsHistogram)
+        .add_property("runNanosecondsHistogram",
+                      &_GetRunNanosecondsHistogram)
+        ;
+
+    def("AreDispatcherStatsEnabled", &WorkAreDispatcherStatsEnabled);
+    def("SetDispatcherStatsEnabled", &WorkSetDispatcherStatsEnabled);
+    def("GetDispatcherStats", &WorkGetDispatcherStats);
+    def("ResetDispatcherStats", &WorkResetDispatcherStats);
+}
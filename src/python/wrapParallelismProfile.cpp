@@ -0,0 +1,49 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/parallelismProfile.h>
+
+#include <pxr/boost/python/class.hpp>
+#include <pxr/boost/python/def.hpp>
+#include <pxr/boost/python/dict.hpp>
+
+using namespace pxr;
+
+using namespace pxr::boost::python;
+
+namespace {
+
+dict
+_GetParallelismProfile()
+{
+    dict result;
+    for (const auto &entry : WorkGetParallelismProfile()) {
+        result[entry.first] = entry.second;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+void wrapParallelismProfile()
+{
+    class_<WorkParallelismRegionStats>("ParallelismRegionStats", no_init)
+        .def_readonly("numInvocations",
+                      &WorkParallelismRegionStats::numInvocations)
+        .def_readonly("wallNanoseconds",
+                      &WorkParallelismRegionStats::wallNanoseconds)
+        .def_readonly("availableNanoseconds",
+                      &WorkParallelismRegionStats::availableNanoseconds)
+        .def_readonly("activeNanoseconds",
+                      &WorkParallelismRegionStats::activeNanoseconds)
+        .def("GetEfficiency", &WorkParallelismRegionStats::GetEfficiency)
+        ;
+
+    def("IsParallelismProfilingEnabled", &WorkIsParallelismProfilingEnabled);
+    def("SetParallelismProfilingEnabled",
+        &WorkSetParallelismProfilingEnabled);
+    def("GetParallelismProfile", &_GetParallelismProfile);
+    def("ResetParallelismProfile", &WorkResetParallelismProfile);
+}
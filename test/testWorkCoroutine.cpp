@@ -0,0 +1,144 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/coroutine.h>
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+static WorkTask<std::string>
+_Read(WorkDispatcher &dispatcher, int i)
+{
+    co_return std::to_string(i);
+}
+
+static WorkTask<int>
+_Parse(WorkDispatcher &dispatcher, std::string str)
+{
+    co_return std::stoi(str);
+}
+
+static WorkTask<int>
+_Process(WorkDispatcher &dispatcher, int i)
+{
+    std::string str = co_await _Read(dispatcher, i);
+    co_return co_await _Parse(dispatcher, std::move(str));
+}
+
+static WorkTask<int>
+_Sum(WorkDispatcher &dispatcher, int n)
+{
+    // Start all tasks before awaiting any of them.
+    std::vector<WorkTask<int>> tasks;
+    for (int i = 0; i != n; ++i) {
+        tasks.push_back(_Process(dispatcher, i));
+    }
+    int sum = 0;
+    for (WorkTask<int> &task : tasks) {
+        sum += co_await std::move(task);
+    }
+    co_return sum;
+}
+
+static void
+_TestChains()
+{
+    WorkDispatcher dispatcher;
+    WorkTask<int> sum = _Sum(dispatcher, 100);
+    TF_AXIOM(sum.Get() == 4950);
+    TF_AXIOM(sum.IsReady());
+
+    // A long chain of awaits must not grow the stack.
+    struct Chain {
+        static WorkTask<int> Run(WorkDispatcher &d, int depth) {
+            if (depth == 0) {
+                co_return 0;
+            }
+            co_return 1 + co_await Run(d, depth - 1);
+        }
+    };
+    TF_AXIOM(Chain::Run(dispatcher, 10000).Get() == 10000);
+    dispatcher.Wait();
+}
+
+static void
+_TestParallelForN()
+{
+    WorkDispatcher dispatcher;
+    std::vector<int> values(10000);
+
+    auto fill = [](WorkDispatcher &d, std::vector<int> &v) -> WorkTask<void> {
+        co_await WorkCoParallelForN(v.size(), [&v](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                v[i] = static_cast<int>(i);
+            }
+        });
+    };
+    WorkTask<void> task = fill(dispatcher, values);
+    TF_AXIOM(task.Wait());
+    for (size_t i = 0; i != values.size(); ++i) {
+        TF_AXIOM(values[i] == static_cast<int>(i));
+    }
+}
+
+static void
+_TestErrors()
+{
+    WorkDispatcher dispatcher;
+    auto fail = [](WorkDispatcher &d) -> WorkTask<int> {
+        TF_CODING_ERROR("Coroutine error");
+        co_return 1;
+    };
+    WorkTask<int> task = fail(dispatcher);
+    TF_AXIOM(task.Get() == 1);
+
+    // Errors are transported to the thread that waits on the dispatcher.
+    TfErrorMark m;
+    dispatcher.Wait();
+    TF_AXIOM(!m.IsClean());
+    m.Clear();
+}
+
+static void
+_TestCancel()
+{
+    WorkDispatcher dispatcher;
+    dispatcher.Cancel();
+
+    std::atomic<bool> resumed(false);
+    auto outer = [](WorkDispatcher &d,
+                    std::atomic<bool> &resumed) -> WorkTask<int> {
+        const int result = co_await _Process(d, 1);
+        resumed = true;
+        co_return result;
+    };
+    WorkTask<int> task = outer(dispatcher, resumed);
+    TF_AXIOM(!task.Wait());
+    TF_AXIOM(!resumed);
+    dispatcher.Wait();
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestChains();
+    _TestParallelForN();
+    _TestErrors();
+    _TestCancel();
+
+    printf("OK\n");
+    return 0;
+}
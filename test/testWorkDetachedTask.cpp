@@ -6,11 +6,18 @@
 // Modified by Jeremy Retailleau.
 
 #include <pxr/work/detachedTask.h>
+#include <pxr/work/threadLimits.h>
 #include <pxr/work/utils.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 
 using namespace pxr;
@@ -48,6 +55,71 @@ struct _SwapOnlyTester {
 
 void swap(_SwapOnlyTester &l, _SwapOnlyTester &r) { std::swap(l.dtor, r.dtor); }
 
+// This type's destructor blocks until released, to observe the accounting of
+// detached tasks while the objects they destroy are still alive.
+struct _SlowDtorTester {
+    _SlowDtorTester() = default;
+    _SlowDtorTester(_SlowDtorTester &&other)
+        : started(other.started), release(other.release) {
+        other.started = nullptr;
+    }
+    ~_SlowDtorTester() {
+        if (started) {
+            *started = true;
+            while (!*release) { std::this_thread::yield(); }
+        }
+    }
+    std::atomic_bool *started = nullptr;
+    std::atomic_bool *release = nullptr;
+};
+
+// Records the threads that destroy instances of this type.
+struct _ThreadRecorder {
+    static std::mutex mutex;
+    static std::set<std::thread::id> threads;
+    static std::atomic<size_t> numDestroyed;
+
+    ~_ThreadRecorder() {
+        // Do enough work for destruction to be worth distributing.
+        const auto end =
+            std::chrono::steady_clock::now() + std::chrono::microseconds(5);
+        while (std::chrono::steady_clock::now() < end) {}
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+        ++numDestroyed;
+    }
+
+    static void Reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.clear();
+        numDestroyed = 0;
+    }
+};
+
+std::mutex _ThreadRecorder::mutex;
+std::set<std::thread::id> _ThreadRecorder::threads;
+std::atomic<size_t> _ThreadRecorder::numDestroyed;
+
+// Destroy numObjects elements with WorkParallelMoveDestroyAsync(), and return
+// the number of distinct threads that destroyed them.
+static size_t
+_ParallelMoveDestroy(size_t numObjects)
+{
+    _ThreadRecorder::Reset();
+    std::vector<std::shared_ptr<_ThreadRecorder>> vec;
+    for (size_t i = 0; i != numObjects; ++i) {
+        vec.push_back(std::make_shared<_ThreadRecorder>());
+    }
+    WorkParallelMoveDestroyAsync(vec);
+    while (_ThreadRecorder::numDestroyed != numObjects) {
+        std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> lock(_ThreadRecorder::mutex);
+    return _ThreadRecorder::threads.size();
+}
+
 int
 main()
 {
@@ -88,5 +160,148 @@ main()
     while (!ranDtor) { /* spin */ std::this_thread::yield(); }
     printf("OK\n");
 
+    printf("Test WorkDeferredMoveDestroyAsync... ");
+    {
+        constexpr size_t numObjects = 10;
+        std::atomic_bool ranDtors[numObjects] = {};
+        for (size_t i = 0; i != numObjects; ++i) {
+            _Tester deferred;
+            deferred.dtor = &ranDtors[i];
+            WorkDeferredMoveDestroyAsync(deferred);
+            TF_AXIOM(!deferred.dtor);
+        }
+        WorkFlushDeferredDestroys();
+        for (size_t i = 0; i != numObjects; ++i) {
+            while (!ranDtors[i]) { /* spin */ std::this_thread::yield(); }
+        }
+    }
+    printf("OK\n");
+
+    printf("Test WorkFlushDeferredDestroys of other threads... ");
+    {
+        // Objects deferred by a thread that is still running are flushed by
+        // another thread.
+        std::atomic_bool deferred { false };
+        std::atomic_bool exit { false };
+        ranDtor = false;
+        std::thread thread([&]() {
+            _Tester obj;
+            obj.dtor = &ranDtor;
+            WorkDeferredMoveDestroyAsync(obj);
+            deferred = true;
+            while (!exit) { std::this_thread::yield(); }
+        });
+        while (!deferred) { std::this_thread::yield(); }
+        TF_AXIOM(!ranDtor);
+        WorkFlushDeferredDestroys();
+        while (!ranDtor) { /* spin */ std::this_thread::yield(); }
+        exit = true;
+        thread.join();
+    }
+    printf("OK\n");
+
+    printf("Test WorkDestroyAsyncBatch... ");
+    {
+        constexpr size_t numObjects = 10;
+        std::atomic_bool ranDtors[numObjects] = {};
+        std::vector<_Tester> batch(numObjects);
+        for (size_t i = 0; i != numObjects; ++i) {
+            batch[i].dtor = &ranDtors[i];
+        }
+        WorkDestroyAsyncBatch(batch, numObjects * sizeof(_Tester));
+        TF_AXIOM(batch.empty());
+        for (size_t i = 0; i != numObjects; ++i) {
+            while (!ranDtors[i]) { /* spin */ std::this_thread::yield(); }
+        }
+    }
+    printf("OK\n");
+
+    printf("Test WorkParallelMoveDestroyAsync... ");
+    {
+        constexpr size_t numObjects = 10000;
+        std::vector<std::weak_ptr<int>> observers;
+        std::vector<std::shared_ptr<int>> vec;
+        std::unordered_map<size_t, std::shared_ptr<int>> map;
+        for (size_t i = 0; i != numObjects; ++i) {
+            vec.push_back(std::make_shared<int>(i));
+            map[i] = std::make_shared<int>(i);
+            observers.push_back(vec.back());
+            observers.push_back(map[i]);
+        }
+        std::vector<bool> bits(numObjects);
+        WorkParallelMoveDestroyAsync(vec);
+        WorkParallelMoveDestroyAsync(map);
+        WorkParallelMoveDestroyAsync(bits);
+        for (const std::weak_ptr<int> &observer : observers) {
+            while (!observer.expired()) { std::this_thread::yield(); }
+        }
+
+        // Small containers are destroyed serially, by a single thread, and
+        // large ones in parallel, when there is concurrency.
+        TF_AXIOM(_ParallelMoveDestroy(Work_ParallelDestroyMinSize / 2) == 1);
+        const size_t numThreads =
+            _ParallelMoveDestroy(Work_ParallelDestroyMinSize * 4);
+        TF_AXIOM(WorkHasConcurrency() ? numThreads > 1 : numThreads == 1);
+    }
+    printf("OK\n");
+
+    // Only meaningful if detached tasks actually run asynchronously, and
+    // otherwise would block forever on the first task.
+    if (WorkHasConcurrency()) {
+        printf("Test detached task limits... ");
+        while (WorkGetDetachedTaskQueueDepth() != 0) {
+            std::this_thread::yield();
+        }
+
+        // Hold one task of 600 bytes in the queue.
+        std::atomic_bool release { false };
+        WorkSetDetachedTaskLimits(2, 1000);
+        WorkRunDetachedTask([&release]() {
+            while (!release) { std::this_thread::yield(); }
+        }, 600);
+        TF_AXIOM(WorkGetDetachedTaskQueueDepth() == 1);
+        TF_AXIOM(WorkGetDetachedTaskBytesPending() == 600);
+
+        // Over the byte limit, so this runs synchronously.
+        ranDtor = false;
+        t.dtor = &ranDtor;
+        WorkMoveDestroyAsync(t, 600);
+        TF_AXIOM(ranDtor);
+
+        // Over the task limit, so this runs synchronously.
+        WorkSetDetachedTaskLimits(1, 0);
+        bool ranInline = false;
+        WorkRunDetachedTask([&ranInline]() { ranInline = true; });
+        TF_AXIOM(ranInline);
+        TF_AXIOM(WorkGetDetachedTaskQueueDepth() == 1);
+
+        release = true;
+        while (WorkGetDetachedTaskQueueDepth() != 0) {
+            std::this_thread::yield();
+        }
+        TF_AXIOM(WorkGetDetachedTaskBytesPending() == 0);
+        WorkSetDetachedTaskLimits(0, 0);
+        printf("OK\n");
+
+        // The reservation of a task is only released once the objects it
+        // destroys are destroyed.
+        printf("Test detached task accounting of destroyed objects... ");
+        std::atomic_bool started { false };
+        release = false;
+        _SlowDtorTester slow;
+        slow.started = &started;
+        slow.release = &release;
+        WorkMoveDestroyAsync(slow, 600);
+        while (!started) { std::this_thread::yield(); }
+        TF_AXIOM(WorkGetDetachedTaskQueueDepth() == 1);
+        TF_AXIOM(WorkGetDetachedTaskBytesPending() == 600);
+        release = true;
+        while (WorkGetDetachedTaskQueueDepth() != 0) {
+            std::this_thread::yield();
+        }
+        TF_AXIOM(WorkGetDetachedTaskBytesPending() == 0);
+        printf("OK\n");
+    }
+
     return 0;
 }
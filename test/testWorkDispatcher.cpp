@@ -6,15 +6,19 @@
 // Modified by Jeremy Retailleau.
 
 #include <pxr/work/dispatcher.h>
+#include <pxr/work/threadLimits.h>
 
+#include <pxr/tf/errorMark.h>
 #include <pxr/tf/iterator.h>
 #include <pxr/tf/stopwatch.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <vector>
 
@@ -376,6 +380,312 @@ _TestDispatcherCancellation(Graph *graph)
     return graph->GetNumNodesRun() == numNodesPerLevel * numLevels;
 }
 
+static void
+_Accumulate(std::atomic<int> *sum, int value, std::unique_ptr<int> const &extra)
+{
+    *sum += value + *extra;
+}
+
+static bool
+_TestRunArguments()
+{
+    // Arguments are stored by value in the task, which allows move-only
+    // arguments, and passed to the callable as lvalues.
+    std::atomic<int> sum(0);
+    {
+        WorkDispatcher dispatcher;
+        for (int i = 0; i != 100; ++i) {
+            dispatcher.Run(&_Accumulate, &sum, i, std::make_unique<int>(1));
+        }
+    }
+    return sum == 4950 + 100;
+}
+
+static bool
+_TestRunBatch()
+{
+    constexpr size_t numTasks = 10000;
+
+    // Every index must be visited exactly once.
+    std::vector<std::atomic<int>> visits(numTasks);
+    {
+        WorkDispatcher dispatcher;
+        dispatcher.RunN(numTasks, [&visits](size_t i) { ++visits[i]; });
+        dispatcher.RunN(0, [](size_t) { TF_FATAL_ERROR("Ran empty batch"); });
+    }
+    for (const std::atomic<int> &v : visits) {
+        if (v != 1) {
+            return false;
+        }
+    }
+
+    std::vector<int> values(numTasks);
+    std::iota(values.begin(), values.end(), 0);
+    std::atomic<size_t> sum(0);
+    {
+        WorkDispatcher dispatcher;
+        dispatcher.RunBatch(values.begin(), values.end(),
+                            [&sum](int value) { sum += value; });
+    }
+    return sum == numTasks * (numTasks - 1) / 2;
+}
+
+static bool
+_TestRunNoErrorTransport()
+{
+    std::atomic<int> sum(0);
+    {
+        WorkDispatcher dispatcher;
+        for (int i = 0; i != 100; ++i) {
+            dispatcher.RunNoErrorTransport([&sum, i]() { sum += i; });
+            dispatcher.RunNoErrorTransport(
+                &_Accumulate, &sum, i, std::make_unique<int>(0));
+        }
+    }
+    return sum == 2 * 4950;
+}
+
+static bool
+_TestPriorities()
+{
+    std::atomic<int> sum(0);
+    {
+        WorkDispatcher low(WorkTaskPriority::Low);
+        WorkDispatcher high(WorkTaskPriority::High);
+        WorkDispatcher normal;
+        for (int i = 0; i != 100; ++i) {
+            low.Run([&sum, i]() { sum += i; });
+            high.Run(&_Accumulate, &sum, i, std::make_unique<int>(0));
+            normal.RunWithPriority(
+                WorkTaskPriority::High, [&sum, i]() { sum += i; });
+            normal.RunWithPriority(
+                WorkTaskPriority::Low, [&sum, i]() { sum += i; });
+        }
+
+        // Tasks may add more tasks from within the priority arena.
+        low.Run([&low, &sum]() {
+            low.RunN(100, [&sum](size_t i) { sum += static_cast<int>(i); });
+        });
+    }
+    if (sum != 5 * 4950) {
+        return false;
+    }
+
+    // Errors are transported from tasks run in priority arenas.
+    TfErrorMark m;
+    {
+        WorkDispatcher low(WorkTaskPriority::Low);
+        low.Run([]() { TF_CODING_ERROR("Error in low priority task"); });
+        low.Wait();
+    }
+    const bool transported = !m.IsClean();
+    m.Clear();
+    return transported;
+}
+
+static bool
+_TestPriorityOrder()
+{
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    // Keep all worker threads busy while low and then high priority tasks
+    // are submitted.  Once released, they must start the high priority tasks
+    // ahead of the low priority ones, even though those were submitted first.
+    // The calling thread does not run any of them before waiting on the low
+    // priority dispatcher last.  Priority arenas are only run by worker
+    // threads, so this requires some.
+    //
+    // Workers may leave the high priority arena as it runs out of tasks, and
+    // start low priority tasks while the last few high priority ones are
+    // still being picked up, so only most of them are required to start
+    // first.
+    if (!WorkHasConcurrency()) {
+        return true;
+    }
+    const int numWorkers = static_cast<int>(WorkGetConcurrencyLimit()) - 1;
+
+    std::atomic<int> blocked(0);
+    std::atomic<bool> released(false);
+    std::atomic<int> sequence(0);
+    std::atomic<int> firstLow(-1);
+    std::vector<int> highSequence(100, -1);
+    {
+        WorkDispatcher normal;
+        WorkDispatcher low(WorkTaskPriority::Low);
+
+        for (int i = 0; i != numWorkers; ++i) {
+            normal.Run([&blocked, &released]() {
+                ++blocked;
+                while (!released) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        while (blocked != numWorkers) {
+            std::this_thread::yield();
+        }
+
+        for (int i = 0; i != 100; ++i) {
+            low.Run([&sequence, &firstLow]() {
+                const int n = sequence++;
+                int expected = -1;
+                firstLow.compare_exchange_strong(expected, n);
+            });
+        }
+        for (int i = 0; i != 100; ++i) {
+            normal.RunWithPriority(WorkTaskPriority::High,
+                [&sequence, &highSequence, i]() {
+                    highSequence[i] = sequence++;
+                });
+        }
+        released = true;
+
+        normal.Wait();
+        low.Wait();
+    }
+
+    const int highFirst = static_cast<int>(std::count_if(
+        highSequence.begin(), highSequence.end(),
+        [&firstLow](int n) { return n < firstLow; }));
+    return sequence == 200 && highFirst >= 90;
+#else
+    return true;
+#endif
+}
+
+static bool
+_TestArena()
+{
+    constexpr int maxConcurrency = 2;
+    WorkArena arena(maxConcurrency);
+    if (arena.GetMaxConcurrency() != maxConcurrency) {
+        return false;
+    }
+
+    // No more than maxConcurrency tasks may run at the same time.
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+    std::atomic<int> count(0);
+    {
+        WorkDispatcher dispatcher(arena);
+        dispatcher.RunN(1000, [&](size_t) {
+            const int r = ++running;
+            int m = maxRunning;
+            while (r > m && !maxRunning.compare_exchange_weak(m, r)) {}
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            ++count;
+            --running;
+        });
+    }
+    if (count != 1000 || maxRunning > maxConcurrency) {
+        return false;
+    }
+
+    // Tasks added from within the arena, which are spawned directly, and
+    // tasks added from another arena both run in the dispatcher's arena.
+    std::atomic<bool> wrongArena(false);
+    std::atomic<int> nestedCount(0);
+    {
+        WorkArena otherArena(1);
+        WorkDispatcher dispatcher(arena);
+        auto checkArena = [&wrongArena]() {
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+            if (tbb::this_task_arena::max_concurrency() != maxConcurrency) {
+                wrongArena = true;
+            }
+#endif
+        };
+        dispatcher.RunN(100, [&](size_t) {
+            checkArena();
+            dispatcher.Run([&]() {
+                checkArena();
+                ++nestedCount;
+            });
+            otherArena.Execute([&]() {
+                dispatcher.Run([&]() {
+                    checkArena();
+                    ++nestedCount;
+                });
+            });
+        });
+    }
+    if (wrongArena || nestedCount != 200) {
+        return false;
+    }
+
+    // Tasks run with a priority in a capped dispatcher remain in its arena.
+    running = 0;
+    maxRunning = 0;
+    count = 0;
+    {
+        WorkDispatcher dispatcher(arena);
+        for (int i = 0; i != 100; ++i) {
+            dispatcher.RunWithPriority(WorkTaskPriority::High, [&]() {
+                const int r = ++running;
+                int m = maxRunning;
+                while (r > m && !maxRunning.compare_exchange_weak(m, r)) {}
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                ++count;
+                --running;
+            });
+        }
+    }
+    if (count != 100 || maxRunning > maxConcurrency) {
+        return false;
+    }
+
+    return arena.Execute([]() { return 42; }) == 42;
+}
+
+static size_t
+_SumHistogram(const WorkDispatcherStats::Histogram &histogram)
+{
+    size_t sum = 0;
+    for (size_t count : histogram) {
+        sum += count;
+    }
+    return sum;
+}
+
+static bool
+_TestStats()
+{
+    const bool enabled = WorkAreDispatcherStatsEnabled();
+
+    // Nothing is recorded while statistics are disabled.
+    WorkSetDispatcherStatsEnabled(false);
+    {
+        WorkDispatcher dispatcher;
+        dispatcher.RunN(10, [](size_t) {});
+        dispatcher.Wait();
+        if (dispatcher.GetStats().numTasksSubmitted != 0) {
+            return false;
+        }
+    }
+
+    WorkSetDispatcherStatsEnabled(true);
+    WorkResetDispatcherStats();
+    WorkDispatcherStats stats;
+    {
+        WorkDispatcher dispatcher;
+        for (int i = 0; i != 100; ++i) {
+            dispatcher.Run([]() {});
+        }
+        dispatcher.Wait();
+        stats = dispatcher.GetStats();
+    }
+    const WorkDispatcherStats processStats = WorkGetDispatcherStats();
+    WorkSetDispatcherStatsEnabled(enabled);
+
+    return stats.numTasksSubmitted == 100 &&
+        stats.numTasksStarted == 100 &&
+        stats.numTasksCompleted == 100 &&
+        stats.numWaits == 1 &&
+        _SumHistogram(stats.queueNanosecondsHistogram) == 100 &&
+        _SumHistogram(stats.runNanosecondsHistogram) == 100 &&
+        processStats.numTasksCompleted == 100 &&
+        processStats.numWaits == 2;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -405,6 +715,34 @@ main(int argc, char **argv)
         if (!_TestDispatcherCancellation<WorkDispatcher>(graph.get())) {
             return 1;
         }
+
+        if (!_TestRunArguments()) {
+            return 1;
+        }
+
+        if (!_TestRunBatch()) {
+            return 1;
+        }
+
+        if (!_TestRunNoErrorTransport()) {
+            return 1;
+        }
+
+        if (!_TestPriorities()) {
+            return 1;
+        }
+
+        if (!_TestPriorityOrder()) {
+            return 1;
+        }
+
+        if (!_TestArena()) {
+            return 1;
+        }
+
+        if (!_TestStats()) {
+            return 1;
+        }
     }
 
     return 0;
@@ -0,0 +1,157 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/future.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+static int
+_Square(int i)
+{
+    return i * i;
+}
+
+static void
+_TestResults()
+{
+    WorkDispatcher dispatcher;
+
+    std::vector<WorkFuture<int>> futures;
+    for (int i = 0; i != 100; ++i) {
+        futures.push_back(dispatcher.RunWithResult(_Square, i));
+    }
+    for (int i = 0; i != 100; ++i) {
+        TF_AXIOM(futures[i].IsValid());
+        TF_AXIOM(futures[i].Get() == i * i);
+        TF_AXIOM(futures[i].IsReady());
+    }
+
+    // Results that are not copyable, and void results.
+    WorkFuture<std::unique_ptr<std::string>> str = dispatcher.RunWithResult(
+        []() { return std::make_unique<std::string>("result"); });
+    TF_AXIOM(*str.Get() == "result");
+
+    std::atomic<bool> ran(false);
+    WorkFuture<void> done = dispatcher.RunWithResult([&ran]() { ran = true; });
+    done.Get();
+    TF_AXIOM(ran);
+
+    TF_AXIOM(!WorkFuture<int>().IsValid());
+}
+
+// Tasks may wait on futures of other tasks of the same dispatcher.
+static void
+_TestNested()
+{
+#if TBB_INTERFACE_VERSION_MAJOR >= 12
+    // Waiting on futures from within tasks requires oneTBB.
+    WorkDispatcher dispatcher;
+    WorkFuture<int> outer = dispatcher.RunWithResult([&dispatcher]() {
+        std::vector<WorkFuture<int>> inner;
+        for (int i = 0; i != 10; ++i) {
+            inner.push_back(dispatcher.RunWithResult(_Square, i));
+        }
+        int sum = 0;
+        for (const WorkFuture<int> &f : inner) {
+            sum += f.Get();
+        }
+        return sum;
+    });
+    TF_AXIOM(outer.Get() == 285);
+#endif
+}
+
+static void
+_TestErrors()
+{
+    WorkDispatcher dispatcher;
+    WorkFuture<int> future = dispatcher.RunWithResult([]() {
+        TF_CODING_ERROR("Task error");
+        return 1;
+    });
+
+    // Errors are not transported to the waiter of the dispatcher, but to the
+    // thread that retrieves the result, once.
+    {
+        TfErrorMark m;
+        dispatcher.Wait();
+        TF_AXIOM(m.IsClean());
+    }
+    {
+        TfErrorMark m;
+        TF_AXIOM(future.Get() == 1);
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+        TF_AXIOM(future.Get() == 1);
+        TF_AXIOM(m.IsClean());
+    }
+}
+
+static void
+_TestCancel()
+{
+    WorkDispatcher dispatcher;
+    std::vector<WorkFuture<int>> futures;
+    dispatcher.Cancel();
+    for (int i = 0; i != 10; ++i) {
+        futures.push_back(dispatcher.RunWithResult(_Square, i));
+    }
+    dispatcher.Wait();
+
+    // Cancelled tasks make their futures ready without a result.
+    for (const WorkFuture<int> &future : futures) {
+        TF_AXIOM(future.IsReady());
+        TF_AXIOM(!future.Wait());
+    }
+}
+
+static void
+_TestCombinators()
+{
+    WorkDispatcher dispatcher;
+    std::vector<WorkFuture<int>> futures;
+    for (int i = 0; i != 20; ++i) {
+        futures.push_back(dispatcher.RunWithResult(_Square, i));
+    }
+
+    WorkFuture<void> all = WorkWhenAll(futures);
+    TF_AXIOM(all.Wait());
+    for (const WorkFuture<int> &future : futures) {
+        TF_AXIOM(future.IsReady());
+    }
+
+    WorkFuture<size_t> any = WorkWhenAny(futures);
+    TF_AXIOM(any.Get() < futures.size());
+    TF_AXIOM(futures[any.Get()].IsReady());
+
+    TF_AXIOM(WorkWhenAll(std::vector<WorkFuture<int>>()).Wait());
+    TF_AXIOM(!WorkWhenAny(std::vector<WorkFuture<int>>()).Wait());
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestResults();
+    _TestNested();
+    _TestErrors();
+    _TestCancel();
+    _TestCombinators();
+
+    printf("OK\n");
+    return 0;
+}
@@ -7,19 +7,29 @@
 
 #include <pxr/work/loops.h>
 
+#include <pxr/work/cancellation.h>
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/reduce.h>
 #include <pxr/work/threadLimits.h>
+#include <pxr/work/tracing.h>
 
 #include <pxr/tf/stopwatch.h>
 #include <pxr/tf/iterator.h>
 #include <pxr/tf/staticData.h>
+#include <pxr/tf/token.h>
+#include <pxr/trace/collection.h>
+#include <pxr/trace/collector.h>
 #include <pxr/arch/fileSystem.h>
 
+#include <atomic>
 #include <functional>
 
 #include <cstdio>
 #include <cstring>
 #include <numeric>
 #include <iostream>
+#include <set>
+#include <string>
 #include <vector>
 
 using namespace std::placeholders;
@@ -115,6 +125,46 @@ _DoTBBTestForEach(
     return sw.GetSeconds();
 }
 
+void
+_DoAdaptiveTest()
+{
+    const size_t N = 100000;
+    std::vector<int> v;
+    _PopulateVector(N, &v);
+    const size_t grainSize =
+        WorkParallelForNAdaptive(N, std::bind(&_Double, _1, _2, &v));
+    TF_AXIOM(grainSize >= 1);
+    _VerifyDoubled(v);
+
+    // Ranges too small to sample must still be covered entirely.
+    for (size_t n = 1; n != 16; ++n) {
+        _PopulateVector(n, &v);
+        WorkParallelForNAdaptive(n, std::bind(&_Double, _1, _2, &v));
+        _VerifyDoubled(v);
+    }
+}
+
+void
+_DoPartitionerTest()
+{
+    const size_t N = 100000;
+    std::vector<int> v;
+
+    // Reusing an affinity partitioner across passes must not change results.
+    WorkAffinityPartitioner affinityPartitioner;
+    for (size_t pass = 0; pass != 3; ++pass) {
+        _PopulateVector(N, &v);
+        WorkParallelForN(
+            N, std::bind(&_Double, _1, _2, &v), 1000, affinityPartitioner);
+        _VerifyDoubled(v);
+    }
+
+    _PopulateVector(N, &v);
+    WorkParallelForN(
+        N, std::bind(&_Double, _1, _2, &v), 1000, WorkStaticPartitioner());
+    _VerifyDoubled(v);
+}
+
 void
 _DoSerialTest()
 {
@@ -125,6 +175,155 @@ _DoSerialTest()
     _VerifyDoubled(v);
 }
 
+static void
+_DoCancellationTest()
+{
+    const size_t N = 100000;
+
+    // A cancelled token skips the loop entirely.
+    WorkCancellationToken token;
+    token.Cancel();
+    std::atomic<size_t> count(0);
+    WorkParallelForN(N, [&count](size_t begin, size_t end) {
+        count += end - begin;
+    }, 1, token);
+    TF_AXIOM(count == 0);
+    TF_AXIOM(WorkParallelReduceN(0, N,
+        [](size_t begin, size_t end, int value) { return value + 1; },
+        [](int lhs, int rhs) { return lhs + rhs; }, 1, token) == 0);
+
+    // Cancelling from within the loop stops it early, but the loop still
+    // returns.
+    WorkCancellationToken copied = WorkCancellationToken();
+    const WorkCancellationToken copy = copied;
+    count = 0;
+    WorkParallelForN(N, [&count, &copied](size_t begin, size_t end) {
+        count += end - begin;
+        copied.Cancel();
+    }, 1, copy);
+    TF_AXIOM(count > 0 && count <= N);
+    TF_AXIOM(copy.IsCancelled());
+
+    // Loops that run serially also stop after the chunk that cancels them.
+    const unsigned concurrencyLimit = WorkGetConcurrencyLimit();
+    WorkSetConcurrencyLimit(1);
+    {
+        const size_t grainSize = 100;
+        WorkCancellationToken serialToken;
+        count = 0;
+        WorkParallelForN(N, [&count, &serialToken](size_t begin, size_t end) {
+            count += end - begin;
+            serialToken.Cancel();
+        }, grainSize, serialToken);
+        TF_AXIOM(count == grainSize);
+
+        WorkCancellationToken reduceToken;
+        const size_t numChunks = WorkParallelReduceN(size_t(0), N,
+            [&reduceToken](size_t begin, size_t end, size_t value) {
+                TF_AXIOM(end - begin <= grainSize);
+                if (value == 2) {
+                    reduceToken.Cancel();
+                }
+                return value + 1;
+            },
+            [](size_t lhs, size_t rhs) { return lhs + rhs; },
+            grainSize, reduceToken);
+        TF_AXIOM(numChunks == 3);
+    }
+    WorkSetConcurrencyLimit(concurrencyLimit);
+
+    // Loops run by tasks of a cancelled dispatcher stop, with tokens linked
+    // to that dispatcher either explicitly or as the enclosing one.
+    WorkDispatcher dispatcher;
+    std::atomic<size_t> linkedCount(0);
+    std::atomic<size_t> enclosingCount(0);
+    dispatcher.Run([&]() {
+        dispatcher.Cancel();
+        WorkParallelForN(N, [&linkedCount](size_t begin, size_t end) {
+            linkedCount += end - begin;
+        }, 1, WorkCancellationToken(dispatcher));
+
+        const WorkCancellationToken enclosing =
+            WorkCancellationToken::GetEnclosing();
+        TF_AXIOM(enclosing.IsCancelled());
+        WorkParallelForN(N, [&enclosingCount](size_t begin, size_t end) {
+            enclosingCount += end - begin;
+        }, 1, enclosing);
+    });
+    dispatcher.Wait();
+    TF_AXIOM(linkedCount == 0);
+    TF_AXIOM(enclosingCount == 0);
+
+    TF_AXIOM(!WorkCancellationToken::GetEnclosing().IsCancelled());
+}
+
+// Collects the keys of the events in a trace collection.
+class _TraceKeyVisitor : public TraceCollection::Visitor
+{
+public:
+    void OnBeginCollection() override {}
+    void OnEndCollection() override {}
+    void OnBeginThread(const TraceThreadId &) override {}
+    void OnEndThread(const TraceThreadId &) override {}
+    bool AcceptsCategory(TraceCategoryId) override { return true; }
+
+    void OnEvent(const TraceThreadId &,
+                 const TfToken &key,
+                 const TraceEvent &) override {
+        keys.insert(key.GetString());
+    }
+
+    std::set<std::string> keys;
+};
+
+// Run a loop with the collector enabled and return the keys of the events
+// it recorded.
+static std::set<std::string>
+_CollectLoopTraceKeys(size_t n, std::vector<int> *v)
+{
+    // Discard any events recorded so far.
+    TraceCollector &collector = TraceCollector::GetInstance();
+    collector.CreateCollection();
+    collector.SetEnabled(true);
+    WorkParallelForN(n, std::bind(&_Double, _1, _2, v));
+    collector.SetEnabled(false);
+
+    _TraceKeyVisitor visitor;
+    collector.CreateCollection()->Iterate(visitor);
+    return visitor.keys;
+}
+
+static void
+_DoTraceTest()
+{
+    const size_t N = 10000;
+    const bool wasEnabled = WorkIsTraceEnabled();
+
+    // Loops record their scopes and chunks with tracing enabled, and give
+    // the same results.
+    WorkSetTraceEnabled(true);
+    TF_AXIOM(WorkIsTraceEnabled());
+
+    std::vector<int> v;
+    _PopulateVector(N, &v);
+    std::set<std::string> keys = _CollectLoopTraceKeys(N, &v);
+    _VerifyDoubled(v);
+    TF_AXIOM(keys.count("WorkParallelForN"));
+    TF_AXIOM(keys.count("WorkParallelForN chunk"));
+
+    // Nothing is recorded with tracing disabled.
+    WorkSetTraceEnabled(false);
+    TF_AXIOM(!WorkIsTraceEnabled());
+
+    _PopulateVector(N, &v);
+    keys = _CollectLoopTraceKeys(N, &v);
+    _VerifyDoubled(v);
+    TF_AXIOM(!keys.count("WorkParallelForN"));
+    TF_AXIOM(!keys.count("WorkParallelForN chunk"));
+
+    WorkSetTraceEnabled(wasEnabled);
+}
+
 // Make sure that the API for WorkParallelForN and WorkSerialForN can be
 // interchanged.  
 void
@@ -144,6 +343,9 @@ _DoSignatureTest()
 
     WorkParallelForN(100, F());
     WorkSerialForN(100, F());
+
+    WorkParallelForNAdaptive(100, f);
+    WorkParallelForNAdaptive(100, F());
 }
 
 
@@ -173,8 +375,16 @@ main(int argc, char **argv)
         << " seconds" << std::endl;
 
 
+    _DoAdaptiveTest();
+
+    _DoPartitionerTest();
+
     _DoSerialTest();
 
+    _DoCancellationTest();
+
+    _DoTraceTest();
+
     _DoSignatureTest();
 
     if (perfMode) {
@@ -0,0 +1,141 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/numaArena.h>
+
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/loops.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace pxr;
+
+static void
+_TestNodes()
+{
+    const std::vector<int> nodes = WorkGetNumaNodes();
+    TF_AXIOM(!nodes.empty());
+    TF_AXIOM(std::is_sorted(nodes.begin(), nodes.end()));
+
+    const std::vector<WorkNumaArena *> &arenas = WorkGetNumaArenas();
+    TF_AXIOM(arenas.size() == nodes.size());
+    for (size_t i = 0; i != arenas.size(); ++i) {
+        TF_AXIOM(arenas[i]->GetNode() == nodes[i]);
+        TF_AXIOM(arenas[i]->GetConcurrency() >= 1);
+        TF_AXIOM(arenas[i]->GetConcurrency() <= WorkGetConcurrencyLimit());
+    }
+    std::cout << "Found " << nodes.size() << " NUMA node(s)" << std::endl;
+}
+
+static void
+_TestExecute()
+{
+    for (WorkNumaArena *arena : WorkGetNumaArenas()) {
+        const size_t n = 100000;
+        std::vector<size_t> values(n, 0);
+        const size_t result = arena->Execute([&]() {
+            WorkParallelForN(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    values[i] = i;
+                }
+            });
+
+            WorkDispatcher dispatcher;
+            std::atomic<size_t> count(0);
+            for (size_t i = 0; i != 100; ++i) {
+                dispatcher.Run([&count]() { ++count; });
+            }
+            dispatcher.Wait();
+            return count.load();
+        });
+
+        TF_AXIOM(result == 100);
+        for (size_t i = 0; i != n; ++i) {
+            TF_AXIOM(values[i] == i);
+        }
+    }
+}
+
+static void
+_TestReplicate()
+{
+    std::mutex mutex;
+    std::vector<int> visited;
+    WorkReplicateAcrossNumaNodes([&](WorkNumaArena &arena) {
+        std::lock_guard<std::mutex> lock(mutex);
+        visited.push_back(arena.GetNode());
+    });
+    std::sort(visited.begin(), visited.end());
+    TF_AXIOM(visited == WorkGetNumaNodes());
+
+    // Errors posted on each node are transported to the calling thread.
+    TfErrorMark m;
+    WorkReplicateAcrossNumaNodes([](WorkNumaArena &arena) {
+        TF_CODING_ERROR("Error on node %d", arena.GetNode());
+    });
+    TF_AXIOM(!m.IsClean());
+    m.Clear();
+
+    // Exceptions are rethrown on the calling thread, once all invocations
+    // that were started complete.
+    std::atomic<size_t> numStarted(0);
+    bool threw = false;
+    try {
+        WorkReplicateAcrossNumaNodes([&](WorkNumaArena &arena) {
+            ++numStarted;
+            throw std::runtime_error("Exception on node");
+        });
+    }
+    catch (const std::runtime_error &) {
+        threw = true;
+    }
+    TF_AXIOM(threw);
+    TF_AXIOM(numStarted >= 1);
+}
+
+static void
+_TestReplicateFromTask()
+{
+    // Replicating from a task, while the only other thread waits on the
+    // dispatcher, must not rely on a free worker thread to run the nodes.
+    std::atomic<size_t> numVisited(0);
+    {
+        WorkDispatcher dispatcher;
+        dispatcher.Run([&numVisited]() {
+            WorkReplicateAcrossNumaNodes([&numVisited](WorkNumaArena &) {
+                ++numVisited;
+            });
+        });
+    }
+    TF_AXIOM(numVisited == WorkGetNumaNodes().size());
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestNodes();
+    _TestExecute();
+    _TestReplicate();
+
+    WorkSetConcurrencyLimit(2);
+    _TestReplicateFromTask();
+
+    WorkSetConcurrencyLimit(1);
+    _TestReplicate();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/parallelismProfile.h>
+#include <pxr/work/loops.h>
+#include <pxr/work/threadLimits.h>
+#include <pxr/work/withScopedParallelism.h>
+
+#include <pxr/tf/diagnostic.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace pxr;
+
+static void
+_Spin(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    // Nothing is recorded while profiling is disabled.
+    WorkSetParallelismProfilingEnabled(false);
+    WorkWithNamedScopedParallelism("disabled", []() {});
+    TF_AXIOM(WorkGetParallelismProfile().empty());
+
+    WorkSetParallelismProfilingEnabled(true);
+    TF_AXIOM(WorkIsParallelismProfilingEnabled());
+
+    // Regions return the result of their function, and nested regions are
+    // recorded separately.
+    std::atomic<size_t> count(0);
+    const int result = WorkWithNamedScopedParallelism("outer", [&count]() {
+        for (int i = 0; i != 3; ++i) {
+            WorkWithNamedScopedParallelism("serial", []() {
+                _Spin(std::chrono::microseconds(2000));
+            });
+        }
+        WorkWithNamedScopedParallelism("parallel", [&count]() {
+            WorkParallelForN(64, [&count](size_t begin, size_t end) {
+                _Spin(std::chrono::microseconds(500 * (end - begin)));
+                count += end - begin;
+            });
+        });
+        return 42;
+    });
+    TF_AXIOM(result == 42);
+    TF_AXIOM(count == 64);
+
+    const auto profile = WorkGetParallelismProfile();
+    TF_AXIOM(profile.size() == 3);
+    TF_AXIOM(profile.at("outer").numInvocations == 1);
+    TF_AXIOM(profile.at("parallel").numInvocations == 1);
+
+    // The serial region keeps the calling thread active.
+    const WorkParallelismRegionStats &serial = profile.at("serial");
+    TF_AXIOM(serial.numInvocations == 3);
+    TF_AXIOM(serial.wallNanoseconds >= 6000000);
+    TF_AXIOM(serial.availableNanoseconds ==
+             serial.wallNanoseconds * WorkGetConcurrencyLimit());
+    TF_AXIOM(serial.activeNanoseconds >= serial.wallNanoseconds);
+    TF_AXIOM(serial.GetEfficiency() > 0.0);
+
+    // Only the calling thread runs the work of the serial region, whereas
+    // the parallel region keeps other threads busy too.
+    const WorkParallelismRegionStats &parallel = profile.at("parallel");
+    if (WorkHasConcurrency()) {
+        const double concurrency = WorkGetConcurrencyLimit();
+        TF_AXIOM(serial.GetEfficiency() < 1.5 / concurrency);
+        TF_AXIOM(parallel.GetEfficiency() > serial.GetEfficiency());
+    }
+
+    // Work run by other threads for a region is also credited to the
+    // enclosing region.
+    const WorkParallelismRegionStats &outer = profile.at("outer");
+    TF_AXIOM(outer.activeNanoseconds + 1000 >= outer.wallNanoseconds +
+             parallel.activeNanoseconds - parallel.wallNanoseconds);
+
+    WorkReportParallelismProfile(std::cout);
+
+    WorkResetParallelismProfile();
+    TF_AXIOM(WorkGetParallelismProfile().empty());
+    WorkSetParallelismProfilingEnabled(false);
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/pipeline.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+static void
+_TestStages(size_t maxTokens)
+{
+    constexpr size_t numItems = 1000;
+
+    size_t next = 0;
+    std::atomic<size_t> inFlight(0);
+    std::atomic<size_t> maxInFlight(0);
+    std::vector<std::string> results;
+
+    WorkRunPipeline(maxTokens,
+        WorkPipeline<void, size_t>(WorkPipelineMode::SerialInOrder,
+            [&]() -> std::optional<size_t> {
+                if (next == numItems) {
+                    return std::nullopt;
+                }
+                const size_t n = ++inFlight;
+                size_t max = maxInFlight;
+                while (n > max && !maxInFlight.compare_exchange_weak(max, n)) {
+                }
+                return next++;
+            }) &
+        WorkPipeline<size_t, std::unique_ptr<size_t>>(
+            WorkPipelineMode::Parallel,
+            [](size_t i) { return std::make_unique<size_t>(i * i); }) &
+        WorkPipeline<std::unique_ptr<size_t>, std::string>(
+            WorkPipelineMode::SerialOutOfOrder,
+            [](std::unique_ptr<size_t> i) { return std::to_string(*i); }) &
+        WorkPipeline<std::string, void>(WorkPipelineMode::SerialInOrder,
+            [&](std::string s) {
+                results.push_back(std::move(s));
+                --inFlight;
+            }));
+
+    // The last stage sees the items in order, and no more than the number of
+    // tokens are in flight at once.
+    TF_AXIOM(results.size() == numItems);
+    for (size_t i = 0; i != numItems; ++i) {
+        TF_AXIOM(results[i] == std::to_string(i * i));
+    }
+    TF_AXIOM(maxInFlight >= 1 && maxInFlight <= maxTokens);
+}
+
+static void
+_TestErrors()
+{
+    size_t next = 0;
+    TfErrorMark m;
+    WorkRunPipeline(4,
+        WorkPipeline<void, int>(WorkPipelineMode::SerialInOrder,
+            [&next]() -> std::optional<int> {
+                if (next == 10) {
+                    return std::nullopt;
+                }
+                return next++;
+            }) &
+        WorkPipeline<int, void>(WorkPipelineMode::Parallel,
+            [](int i) {
+                if (i % 5 == 0) {
+                    TF_CODING_ERROR("Error in stage for item %d", i);
+                }
+            }));
+
+    // Errors are posted on the calling thread.
+    size_t numErrors = 0;
+    m.GetBegin(&numErrors);
+    TF_AXIOM(numErrors == 2);
+    m.Clear();
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestStages(1);
+    _TestStages(8);
+    _TestErrors();
+
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/pipelineQueue.h>
+#include <pxr/work/dispatcher.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace pxr;
+
+static void
+_TestProducersAndConsumers()
+{
+    constexpr size_t numProducers = 16;
+    constexpr size_t numValues = 10000;
+    constexpr size_t maxBatchSize = 8;
+
+    std::atomic<size_t> count(0);
+    std::atomic<size_t> sum(0);
+    std::atomic<bool> batchTooLarge(false);
+
+    WorkDispatcher dispatcher;
+    {
+        // Use a small capacity so that producers fill the queue and consume
+        // batches themselves.
+        WorkPipelineQueue<size_t> queue(dispatcher, 16,
+            [&](std::vector<size_t> &batch) {
+                if (batch.empty() || batch.size() > maxBatchSize) {
+                    batchTooLarge = true;
+                }
+                for (size_t value : batch) {
+                    sum += value;
+                }
+                count += batch.size();
+            }, 0, maxBatchSize);
+        TF_AXIOM(queue.GetCapacity() == 16);
+
+        dispatcher.RunN(numProducers, [&queue](size_t producer) {
+            for (size_t i = 0; i != numValues; ++i) {
+                queue.Push(i);
+            }
+        });
+        dispatcher.Wait();
+        TF_AXIOM(queue.GetSize() == 0);
+    }
+
+    TF_AXIOM(!batchTooLarge);
+    TF_AXIOM(count == numProducers * numValues);
+    TF_AXIOM(sum == numProducers * numValues * (numValues - 1) / 2);
+}
+
+static void
+_TestFullQueue()
+{
+    // Consumer tasks of a cancelled dispatcher never run, so the queue fills
+    // up, and the remaining elements are destroyed with it.
+    std::atomic<size_t> consumed(0);
+    std::shared_ptr<int> element = std::make_shared<int>(0);
+
+    WorkDispatcher dispatcher;
+    dispatcher.Cancel();
+    {
+        WorkPipelineQueue<std::shared_ptr<int>> queue(dispatcher, 5,
+            [&consumed](std::vector<std::shared_ptr<int>> &batch) {
+                consumed += batch.size();
+            });
+        TF_AXIOM(queue.GetCapacity() == 8);
+
+        for (size_t i = 0; i != 8; ++i) {
+            TF_AXIOM(queue.TryPush(element));
+        }
+        TF_AXIOM(!queue.TryPush(element));
+        TF_AXIOM(queue.GetSize() == 8);
+        TF_AXIOM(element.use_count() == 9);
+
+        // Pushing to the full queue consumes a batch on the calling thread.
+        queue.Push(element);
+        TF_AXIOM(consumed == 8);
+        TF_AXIOM(queue.GetSize() == 1);
+
+        dispatcher.Wait();
+    }
+    TF_AXIOM(element.use_count() == 1);
+}
+
+static void
+_TestReuseAfterCancel()
+{
+    // Consumers of a cancelled dispatcher that did not run no longer count
+    // as running, so that once the dispatcher has been waited on, pushing
+    // starts a consumer that takes all the elements.
+    std::atomic<size_t> consumed(0);
+
+    WorkDispatcher dispatcher;
+    WorkPipelineQueue<int> queue(dispatcher, 64,
+        [&consumed](std::vector<int> &batch) {
+            consumed += batch.size();
+        });
+
+    dispatcher.Cancel();
+    for (int i = 0; i != 10; ++i) {
+        TF_AXIOM(queue.TryPush(i));
+    }
+    dispatcher.Wait();
+    TF_AXIOM(consumed == 0);
+    TF_AXIOM(queue.GetSize() == 10);
+
+    queue.Push(10);
+    dispatcher.Wait();
+    TF_AXIOM(consumed == 11);
+    TF_AXIOM(queue.GetSize() == 0);
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestProducersAndConsumers();
+    _TestFullQueue();
+    _TestReuseAfterCancel();
+
+    printf("OK\n");
+    return 0;
+}
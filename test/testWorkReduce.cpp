@@ -77,6 +77,74 @@ _DoTBBTest(bool verify, const int arraySize, const size_t numIterations)
     return sw.GetSeconds();
 }
 
+static void
+_DoPartitionerTest()
+{
+    const int arraySize = 10000;
+    const int expected = arraySize*(arraySize-1)/2;
+    std::vector<int> v;
+    _PopulateVector(arraySize, v);
+
+    WorkAffinityPartitioner affinityPartitioner;
+    for (size_t pass = 0; pass != 3; ++pass) {
+        const int res = WorkParallelReduceN(0, arraySize,
+            std::bind(&sum, _1, _2, _3, std::cref(v)),
+            std::bind(&plus, _1, _2),
+            1000, affinityPartitioner);
+        TF_AXIOM(res == expected);
+    }
+
+    const int res = WorkParallelReduceN(0, arraySize,
+        std::bind(&sum, _1, _2, _3, std::cref(v)),
+        std::bind(&plus, _1, _2),
+        1000, WorkStaticPartitioner());
+    TF_AXIOM(res == expected);
+}
+
+static double
+_DeterministicSum(const std::vector<double> &v, size_t grainSize)
+{
+    return WorkParallelDeterministicReduceN(0.0, v.size(),
+        [&v](size_t begin, size_t end, double val) {
+            for (size_t i = begin; i < end; ++i)
+                val += v[i];
+            return val;
+        },
+        [](double lhs, double rhs) { return lhs + rhs; },
+        grainSize);
+}
+
+// Make sure floating-point sums give the same bits regardless of the
+// concurrency limit.
+static void
+_DoDeterministicTest()
+{
+    // Values of very different magnitudes, so that the result depends on the
+    // order of the additions.
+    std::vector<double> v(100000);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = (i % 7 == 0 ? 1e12 : 1e-3) * ((i % 3) ? 1.0 : -1.0) + i;
+    }
+
+    const double expected = _DeterministicSum(v, 100);
+    for (size_t pass = 0; pass != 10; ++pass) {
+        TF_AXIOM(_DeterministicSum(v, 100) == expected);
+    }
+
+    const unsigned limit = WorkGetConcurrencyLimit();
+    WorkSetConcurrencyLimit(1);
+    TF_AXIOM(_DeterministicSum(v, 100) == expected);
+    WorkSetConcurrencyLimit(limit);
+
+    // The default grain size only depends on the size of the range.
+    const int res = WorkParallelDeterministicReduceN(0, 10000,
+        [](size_t begin, size_t end, int val) {
+            return val + static_cast<int>(end - begin);
+        },
+        [](int lhs, int rhs) { return lhs + rhs; });
+    TF_AXIOM(res == 10000);
+}
+
 // Make sure that the API for WorkParallelReduceN can be
 // interchanged.  
 void
@@ -105,6 +173,10 @@ _DoSignatureTest()
     WorkParallelReduceN(initial, 100, f, b);
 
     WorkParallelReduceN(initial, 100, F(), B());
+
+    WorkParallelDeterministicReduceN(initial, 100, f, b);
+
+    WorkParallelDeterministicReduceN(initial, 100, F(), B(), 10);
 }
 
 
@@ -125,6 +197,10 @@ main(int argc, char **argv)
     std::cout << "TBB parallel_reduce.h took: " << tbbSeconds << " seconds" 
         << std::endl;
 
+    _DoPartitionerTest();
+
+    _DoDeterministicTest();
+
     _DoSignatureTest();
 
     if (perfMode) {
@@ -0,0 +1,135 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/scan.h>
+#include <pxr/work/dispatcher.h>
+
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace pxr;
+
+static std::vector<int>
+_MakeInput(size_t arraySize)
+{
+    std::vector<int> v(arraySize);
+    for (int &i : v) {
+        i = std::rand() % 100;
+    }
+    return v;
+}
+
+static void
+_DoScanTest(size_t arraySize, size_t grainSize)
+{
+    const std::vector<int> input = _MakeInput(arraySize);
+    std::vector<long> output(arraySize, -1);
+
+    const long total = WorkParallelScanN(0L, arraySize,
+        [&](size_t begin, size_t end, long prefix, bool isFinal) {
+            for (size_t i = begin; i != end; ++i) {
+                prefix += input[i];
+                if (isFinal) {
+                    output[i] = prefix;
+                }
+            }
+            return prefix;
+        },
+        [](long lhs, long rhs) { return lhs + rhs; },
+        grainSize);
+
+    long expected = 0;
+    for (size_t i = 0; i != arraySize; ++i) {
+        expected += input[i];
+        TF_AXIOM(output[i] == expected);
+    }
+    TF_AXIOM(total == expected);
+}
+
+static void
+_DoInclusiveExclusiveTest(size_t arraySize)
+{
+    const std::vector<int> input = _MakeInput(arraySize);
+    auto plus = [](long lhs, long rhs) { return lhs + rhs; };
+
+    std::vector<long> inclusive(arraySize);
+    const long inclusiveTotal = WorkParallelInclusiveScanN(
+        0L, arraySize, input.begin(), inclusive.begin(), plus);
+
+    std::vector<long> exclusive(arraySize);
+    const long exclusiveTotal = WorkParallelExclusiveScanN(
+        0L, arraySize, input.begin(), exclusive.begin(), plus, 1000);
+
+    long expected = 0;
+    for (size_t i = 0; i != arraySize; ++i) {
+        TF_AXIOM(exclusive[i] == expected);
+        expected += input[i];
+        TF_AXIOM(inclusive[i] == expected);
+    }
+    TF_AXIOM(inclusiveTotal == expected);
+    TF_AXIOM(exclusiveTotal == expected);
+
+    // Scan in-place, computing offsets from sizes.
+    std::vector<int> offsets = input;
+    const int total = WorkParallelExclusiveScanN(
+        0, arraySize, offsets.begin(), offsets.begin(),
+        [](int lhs, int rhs) { return lhs + rhs; });
+    TF_AXIOM(total == std::accumulate(input.begin(), input.end(), 0));
+    for (size_t i = 1; i < arraySize; ++i) {
+        TF_AXIOM(offsets[i] == offsets[i-1] + input[i-1]);
+    }
+}
+
+static void
+_DoCancelledDispatcherTest(size_t arraySize)
+{
+    // Scans run in tasks of a cancelled dispatcher are not cut short.
+    const std::vector<int> input = _MakeInput(arraySize);
+    std::vector<long> output(arraySize);
+    long total = -1;
+    WorkDispatcher dispatcher;
+    dispatcher.Run([&]() {
+        dispatcher.Cancel();
+        total = WorkParallelInclusiveScanN(
+            0L, arraySize, input.begin(), output.begin(),
+            [](long lhs, long rhs) { return lhs + rhs; });
+    });
+    dispatcher.Wait();
+
+    long expected = 0;
+    for (size_t i = 0; i != arraySize; ++i) {
+        expected += input[i];
+        TF_AXIOM(output[i] == expected);
+    }
+    TF_AXIOM(total == expected);
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    std::cout << "Initialized with " <<
+        WorkGetPhysicalConcurrencyLimit() << " cores..." << std::endl;
+
+    _DoScanTest(1000000, 1);
+    _DoScanTest(1000000, 10000);
+    _DoScanTest(0, 1);
+    _DoInclusiveExclusiveTest(1000000);
+    _DoCancelledDispatcherTest(1000000);
+
+    WorkSetConcurrencyLimit(1);
+    _DoScanTest(100000, 1);
+    _DoInclusiveExclusiveTest(100000);
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
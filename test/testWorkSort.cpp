@@ -12,9 +12,12 @@
 #include <pxr/tf/diagnostic.h>
 #include <pxr/tf/stopwatch.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 using namespace pxr;
@@ -55,6 +58,73 @@ _DoTBBTest(const size_t arraySize, const size_t numIterations)
     return sw.GetSeconds();
 }
 
+// Pairs of a key with few distinct values and the original index, to check
+// that elements with equal keys keep their order.
+static std::vector<std::pair<int, size_t>>
+_MakeKeyedVector(const size_t arraySize)
+{
+    std::vector<std::pair<int, size_t>> v;
+    v.reserve(arraySize);
+    for (size_t i = 0; i < arraySize; ++i) {
+        v.emplace_back(std::rand() % 1000 - 500, i);
+    }
+    return v;
+}
+
+static void
+_VerifyStable(const std::vector<std::pair<int, size_t>> &v)
+{
+    for (size_t i = 1; i < v.size(); ++i) {
+        TF_AXIOM(v[i-1].first <= v[i].first);
+        if (v[i-1].first == v[i].first) {
+            TF_AXIOM(v[i-1].second < v[i].second);
+        }
+    }
+}
+
+static void
+_DoStableSortTest(const size_t arraySize)
+{
+    std::vector<std::pair<int, size_t>> v = _MakeKeyedVector(arraySize);
+    WorkParallelStableSort(&v,
+        [](const std::pair<int, size_t> &lhs,
+           const std::pair<int, size_t> &rhs) {
+            return lhs.first < rhs.first;
+        });
+    _VerifyStable(v);
+
+    std::vector<int> ints;
+    _PopulateVector(arraySize, &ints);
+    std::vector<int> expected = ints;
+    std::sort(expected.begin(), expected.end());
+    WorkParallelStableSort(&ints);
+    TF_AXIOM(ints == expected);
+}
+
+static void
+_DoRadixSortTest(const size_t arraySize)
+{
+    std::vector<std::pair<int, size_t>> v = _MakeKeyedVector(arraySize);
+    WorkParallelRadixSort(&v, [](const std::pair<int, size_t> &value) {
+        return value.first;
+    });
+    _VerifyStable(v);
+
+    std::vector<int64_t> ints(arraySize);
+    for (int64_t &i : ints) {
+        i = (int64_t(std::rand()) << 32 | std::rand()) - (int64_t(1) << 61);
+    }
+    std::vector<int64_t> expected = ints;
+    std::sort(expected.begin(), expected.end());
+    WorkParallelRadixSort(&ints);
+    TF_AXIOM(ints == expected);
+
+    // All keys equal: every pass is skipped.
+    std::vector<uint32_t> same(arraySize, 42);
+    WorkParallelRadixSort(&same);
+    TF_AXIOM(std::all_of(same.begin(), same.end(),
+                         [](uint32_t i) { return i == 42; }));
+}
 
 int
 main(int argc, char **argv)
@@ -72,5 +142,12 @@ main(int argc, char **argv)
     std::cout << "TBB parallel_sort.h took: " << tbbSeconds << " seconds" 
         << std::endl;
 
+    _DoStableSortTest(arraySize);
+    _DoRadixSortTest(arraySize);
+
+    // Small containers are sorted serially.
+    _DoStableSortTest(100);
+    _DoRadixSortTest(100);
+
     return 0;
 }
@@ -0,0 +1,111 @@
+// Copyright 2026 Jeremy Retailleau
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+
+#include <pxr/work/taskGraph.h>
+#include <pxr/work/threadLimits.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+using namespace pxr;
+
+// Build a diamond-shaped graph repeated in layers, and check that every node
+// runs once per execution, after all of its predecessors.
+static void
+_TestOrdering()
+{
+    constexpr size_t numLayers = 50;
+    constexpr size_t width = 8;
+    constexpr size_t numExecutions = 10;
+
+    WorkTaskGraph graph;
+    std::vector<std::atomic<size_t>> runCounts(numLayers * width + 1);
+    std::vector<std::vector<WorkTaskGraph::NodeId>> preds;
+
+    const WorkTaskGraph::NodeId root = graph.AddNode([&]() {
+        ++runCounts[0];
+    });
+    preds.push_back({});
+    TF_AXIOM(root == 0);
+
+    std::vector<WorkTaskGraph::NodeId> prevLayer = { root };
+    for (size_t layer = 0; layer != numLayers; ++layer) {
+        std::vector<WorkTaskGraph::NodeId> curLayer;
+        for (size_t i = 0; i != width; ++i) {
+            const WorkTaskGraph::NodeId id = graph.GetNumNodes();
+            graph.AddNode([&, id]() {
+                for (WorkTaskGraph::NodeId pred : preds[id]) {
+                    TF_AXIOM(runCounts[pred] == runCounts[id] + 1);
+                }
+                ++runCounts[id];
+            }, prevLayer);
+            preds.push_back(prevLayer);
+            curLayer.push_back(id);
+        }
+        prevLayer = curLayer;
+    }
+
+    TF_AXIOM(graph.GetNumNodes() == numLayers * width + 1);
+    TF_AXIOM(graph.GetCriticalPathLength() == numLayers + 1);
+    TF_AXIOM(graph.GetLastCriticalPathSeconds() == 0.0);
+
+    for (size_t i = 0; i != numExecutions; ++i) {
+        graph.Execute();
+    }
+    for (const std::atomic<size_t> &count : runCounts) {
+        TF_AXIOM(count == numExecutions);
+    }
+    TF_AXIOM(graph.GetLastCriticalPathSeconds() >= 0.0);
+
+    graph.Clear();
+    TF_AXIOM(graph.GetNumNodes() == 0);
+    TF_AXIOM(graph.GetCriticalPathLength() == 0);
+    graph.Execute();
+}
+
+static void
+_TestInvalidPredecessor()
+{
+    WorkTaskGraph graph;
+    int count = 0;
+
+    TfErrorMark m;
+    graph.AddNode([&count]() { ++count; }, { 3 });
+    TF_AXIOM(!m.IsClean());
+    m.Clear();
+
+    graph.Execute();
+    TF_AXIOM(count == 1);
+}
+
+static void
+_TestErrors()
+{
+    WorkTaskGraph graph;
+    const WorkTaskGraph::NodeId a = graph.AddNode([]() {});
+    graph.AddNode([]() { TF_CODING_ERROR("Node error"); }, { a });
+
+    TfErrorMark m;
+    graph.Execute();
+    TF_AXIOM(!m.IsClean());
+    m.Clear();
+}
+
+int
+main()
+{
+    WorkSetMaximumConcurrencyLimit();
+
+    _TestOrdering();
+    _TestInvalidPredecessor();
+    _TestErrors();
+
+    printf("OK\n");
+    return 0;
+}